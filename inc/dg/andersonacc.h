@@ -211,8 +211,13 @@ unsigned AndersonAcceleration<ContainerType>::solve(
                 //Here should be the check for whether to proceed.
 
                 //Solve least squares problem.
+                //(all scalar products Q(:,i)'*m_fval in one reduction)
+                std::vector<const ContainerType*> qs( mAA), fs( mAA, &m_fval);
+                for( unsigned i=0; i<mAA; i++)
+                    qs[i] = &m_Q[i];
+                std::vector<value_type> qf = dg::blas1::dot_batch( qs, fs);
                 for(int i = (int)mAA-1; i>=0; i--){
-                    m_gamma[i] = dg::blas1::dot(m_Q[i],m_fval);
+                    m_gamma[i] = qf[i];
                     for(int j = i + 1; j < (int)mAA; j++){
                         m_gamma[i] -= m_R[i][j]*m_gamma[j];
                     }
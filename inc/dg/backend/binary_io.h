@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <thrust/host_vector.h>
+#include <thrust/copy.h>
+#include "exceptions.h"
+#include "tensor_traits.h"
+#include "tensor_traits_scalar.h"
+#include "tensor_traits_thrust.h"
+#include "tensor_traits_std.h"
+
+/*!@file
+ *
+ * Raw binary input and output of containers (used for checkpoints)
+ */
+
+namespace dg
+{
+///@cond
+namespace detail
+{
+//every call to write_binary starts with this header
+const uint32_t binary_magic = 0x6e626764; //"dgbn" on little endian machines
+const uint32_t binary_version = 1;
+template<class T>
+uint32_t binary_type_code()
+{
+    return std::is_floating_point<T>::value ? 1 :
+           std::is_integral<T>::value ? ( std::is_signed<T>::value ? 2 : 3) : 0;
+}
+template<class T>
+void write_header( std::ostream& os)
+{
+    uint32_t header[4] = { binary_magic, binary_version, binary_type_code<T>(), sizeof(T)};
+    os.write( reinterpret_cast<const char*>( header), sizeof(header));
+}
+template<class T>
+void read_header( std::istream& is)
+{
+    uint32_t header[4] = {0,0,0,0};
+    is.read( reinterpret_cast<char*>( header), sizeof(header));
+    if( !is)
+        throw dg::Error( dg::Message(_ping_)<<"Reading binary data failed!");
+    if( header[0] != binary_magic)
+        throw dg::Error( dg::Message(_ping_)<<"Binary data was not written by dg::write_binary (or on a machine with different endianness)!");
+    if( header[1] != binary_version)
+        throw dg::Error( dg::Message(_ping_)<<"Binary data has format version "<<header[1]<<" but version "<<binary_version<<" is expected!");
+    if( header[2] != binary_type_code<T>() || header[3] != sizeof(T))
+        throw dg::Error( dg::Message(_ping_)<<"Value type (code "<<header[2]<<", "<<header[3]<<" bytes) in binary data does not match value type (code "<<binary_type_code<T>()<<", "<<sizeof(T)<<" bytes) of container!");
+}
+template<class T>
+void do_write_binary( std::ostream& os, const T& x, AnyScalarTag)
+{
+    os.write( reinterpret_cast<const char*>( &x), sizeof(T));
+}
+template<class T>
+void do_read_binary( std::istream& is, T& x, AnyScalarTag)
+{
+    is.read( reinterpret_cast<char*>( &x), sizeof(T));
+}
+inline void write_size( std::ostream& os, uint64_t size)
+{
+    os.write( reinterpret_cast<const char*>( &size), sizeof(size));
+}
+inline void read_size( std::istream& is, uint64_t size)
+{
+    uint64_t stored = 0;
+    is.read( reinterpret_cast<char*>( &stored), sizeof(stored));
+    if( !is)
+        throw dg::Error( dg::Message(_ping_)<<"Reading binary data failed!");
+    if( stored != size)
+        throw dg::Error( dg::Message(_ping_)<<"Size "<<stored<<" in binary data does not match size "<<size<<" of container!");
+}
+template<class ContainerType>
+void do_write_binary( std::ostream& os, const ContainerType& x, SharedVectorTag)
+{
+    using value_type = get_value_type<ContainerType>;
+    //copy to host (does nothing but a copy on the host)
+    thrust::host_vector<value_type> host( x.begin(), x.end());
+    write_size( os, host.size());
+    os.write( reinterpret_cast<const char*>( thrust::raw_pointer_cast( host.data())), host.size()*sizeof(value_type));
+}
+template<class ContainerType>
+void do_read_binary( std::istream& is, ContainerType& x, SharedVectorTag)
+{
+    using value_type = get_value_type<ContainerType>;
+    read_size( is, x.size());
+    thrust::host_vector<value_type> host( x.size());
+    is.read( reinterpret_cast<char*>( thrust::raw_pointer_cast( host.data())), host.size()*sizeof(value_type));
+    thrust::copy( host.begin(), host.end(), x.begin());
+}
+template<class ContainerType>
+void do_write_binary( std::ostream& os, const ContainerType& x, MPIVectorTag)
+{
+    //each process writes its local part
+    do_write_binary( os, x.data(), get_tensor_category<decltype(x.data())>());
+}
+template<class ContainerType>
+void do_read_binary( std::istream& is, ContainerType& x, MPIVectorTag)
+{
+    do_read_binary( is, x.data(), get_tensor_category<decltype(x.data())>());
+}
+template<class ContainerType>
+void do_write_binary( std::ostream& os, const ContainerType& x, RecursiveVectorTag)
+{
+    write_size( os, x.size());
+    for( unsigned i=0; i<x.size(); i++)
+        do_write_binary( os, x[i], get_tensor_category<decltype(x[i])>());
+}
+template<class ContainerType>
+void do_read_binary( std::istream& is, ContainerType& x, RecursiveVectorTag)
+{
+    read_size( is, x.size());
+    for( unsigned i=0; i<x.size(); i++)
+        do_read_binary( is, x[i], get_tensor_category<decltype(x[i])>());
+}
+}//namespace detail
+///@endcond
+
+///@addtogroup blas
+///@{
+
+/**
+ * @brief Write the raw binary data of a container to a stream
+ *
+ * The data is preceded by a header that contains a magic number, the
+ * version of the format and the kind and size of the value type.
+ * Vectors are preceded by their size, scalars are written as they are. In
+ * an MPI environment each process writes only its local data, that is the
+ * stream is usually a file that belongs to the calling process.
+ * The data is copied to the host before it is written.
+ * @code
+std::ofstream os( "checkpoint.bin", std::ios::binary);
+dg::write_binary( os, y0); //e.g. std::array<dg::DVec,2>
+ * @endcode
+ * @param os the output stream (should be opened with \c std::ios::binary)
+ * @param x the container to write
+ * @note the format is only meant to be read by \c dg::read_binary on the same
+ * kind of machine and with the same number of processes
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerType>
+void write_binary( std::ostream& os, const ContainerType& x)
+{
+    detail::write_header<get_value_type<ContainerType>>( os);
+    detail::do_write_binary( os, x, get_tensor_category<ContainerType>());
+}
+
+/**
+ * @brief Read the raw binary data written by \c dg::write_binary into a container
+ *
+ * @param is the input stream (should be opened with \c std::ios::binary)
+ * @param x (write-only) must have the same sizes as the written container
+ * @throw dg::Error if the header is not valid (e.g. the data was written
+ * by a different version of the format), if the stored value type (e.g.
+ * \c float instead of \c double) or the stored sizes (e.g. from a different
+ * grid) do not match the ones of \c x or if the stream fails
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerType>
+void read_binary( std::istream& is, ContainerType& x)
+{
+    detail::read_header<get_value_type<ContainerType>>( is);
+    detail::do_read_binary( is, x, get_tensor_category<ContainerType>());
+    if( !is)
+        throw dg::Error( dg::Message(_ping_)<<"Reading binary data failed!");
+}
+///@}
+
+}//namespace dg
@@ -35,6 +35,23 @@ inline std::vector<int64_t> doDot_dispatch( CudaTag, unsigned size, PointerOrVal
     cudaMemcpy( &h_superacc[0], d_ptr, exblas::BIN_COUNT*sizeof(int64_t), cudaMemcpyDeviceToHost);
     return h_superacc;
 }
+//the products are computed one after the other but copied to the host at once
+template<class T1, class T2>
+inline std::vector<int64_t> doDot_batch_dispatch( CudaTag, unsigned size, unsigned num, const T1* const* x_ptrs, const T2* const* y_ptrs) {
+    static thrust::device_vector<int64_t> d_superacc;
+    d_superacc.resize( num*exblas::BIN_COUNT);
+    int64_t * d_ptr = thrust::raw_pointer_cast( d_superacc.data());
+    for( unsigned k=0; k<num; k++)
+    {
+        int status = 0;
+        exblas::exdot_gpu( size, x_ptrs[k], y_ptrs[k], d_ptr+k*exblas::BIN_COUNT, &status);
+        if( status != 0)
+            throw dg::Error(dg::Message(_ping_)<<"GPU Dot product failed since one of the inputs contains NaN or Inf");
+    }
+    std::vector<int64_t> h_superacc(num*exblas::BIN_COUNT);
+    cudaMemcpy( &h_superacc[0], d_ptr, num*exblas::BIN_COUNT*sizeof(int64_t), cudaMemcpyDeviceToHost);
+    return h_superacc;
+}
 
 template<class T>
 __device__
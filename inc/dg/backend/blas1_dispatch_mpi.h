@@ -81,6 +81,39 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Vector2& y, MPIVect
     return receive;
 }
 
+//local computation of all products and then a single reduction of all superaccumulators
+template< class Vector1, class Vector2>
+std::vector<int64_t> doDot_superacc_batch( const std::vector<const Vector1*>& x, const std::vector<const Vector2*>& y, MPIVectorTag)
+{
+    unsigned num = x.size();
+    std::vector<const typename Vector1::container_type*> x_data( num);
+    std::vector<const typename Vector2::container_type*> y_data( num);
+    for( unsigned k=0; k<num; k++)
+    {
+#ifdef DG_DEBUG
+        mpi_assert( *x[k],*y[k]);
+#endif //DG_DEBUG
+        x_data[k] = &x[k]->data();
+        y_data[k] = &y[k]->data();
+    }
+    std::vector<int64_t> acc = doDot_superacc_batch( x_data, y_data);
+    std::vector<int64_t> receive(num*exblas::BIN_COUNT, (int64_t)0);
+    exblas::reduce_mpi_cpu( num, acc.data(), receive.data(), x[0]->communicator(),
+        x[0]->communicator_mod(), x[0]->communicator_mod_reduce());
+    return receive;
+}
+
+//local computation only, the superaccumulator still needs to be reduced among processes
+template< class Vector1, class Vector2>
+std::vector<int64_t> doDot_superacc_local( const Vector1& x, const Vector2& y, MPIVectorTag)
+{
+#ifdef DG_DEBUG
+    mpi_assert( x,y);
+#endif //DG_DEBUG
+    return doDot_superacc(
+        do_get_data(x,get_tensor_category<Vector1>()),
+        do_get_data(y,get_tensor_category<Vector2>()));
+}
 
 template< class Subroutine, class container, class ...Containers>
 inline void doSubroutine( MPIVectorTag, Subroutine f, container&& x, Containers&&... xs)
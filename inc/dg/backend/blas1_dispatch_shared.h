@@ -48,6 +48,8 @@ namespace detail
 {
 template< class ContainerType1, class ContainerType2>
 inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const ContainerType2& y);
+template< class ContainerType1, class ContainerType2>
+inline std::vector<int64_t> doDot_superacc_batch( const std::vector<const ContainerType1*>& x, const std::vector<const ContainerType2*>& y);
 //we need to distinguish between Scalars and Vectors
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +75,34 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Vector2& y, SharedV
             do_get_pointer_or_reference(y, get_tensor_category<Vector2>()));
 }
 
+//all x[k]^T y[k] with one sweep through memory
+template< class Vector1, class Vector2>
+std::vector<int64_t> doDot_superacc_batch( const std::vector<const Vector1*>& x, const std::vector<const Vector2*>& y, SharedVectorTag)
+{
+    static_assert( std::is_convertible<get_value_type<Vector1>, double>::value, "We only support double precision dot products at the moment!");
+    static_assert( std::is_convertible<get_value_type<Vector2>, double>::value, "We only support double precision dot products at the moment!");
+    using execution_policy = get_execution_policy<Vector1>;
+    static_assert( dg::has_any_or_same_policy<Vector2, execution_policy>::value,
+        "All ContainerType types must have compatible execution policies (AnyPolicy or Same)!");
+    unsigned num = x.size();
+    std::vector<const get_value_type<Vector1>*> x_ptrs( num);
+    std::vector<const get_value_type<Vector2>*> y_ptrs( num);
+    for( unsigned k=0; k<num; k++)
+    {
+        x_ptrs[k] = do_get_pointer_or_reference( *x[k], SharedVectorTag());
+        y_ptrs[k] = do_get_pointer_or_reference( *y[k], SharedVectorTag());
+    }
+    return dg::blas1::detail::doDot_batch_dispatch( execution_policy(),
+            x[0]->size(), num, x_ptrs.data(), y_ptrs.data());
+}
+
+//the local part of a dot product is the dot product unless the vectors are distributed among processes
+template< class Vector1, class Vector2, class Tag>
+inline std::vector<int64_t> doDot_superacc_local( const Vector1& x, const Vector2& y, Tag)
+{
+    return doDot_superacc( x, y);
+}
+
 template< class Subroutine, class ContainerType, class ...ContainerTypes>
 inline void doSubroutine( SharedVectorTag, Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
 {
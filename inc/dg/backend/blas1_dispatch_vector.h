@@ -155,6 +155,37 @@ inline std::vector<int64_t> doDot_superacc( const Vector1& x1, const Vector2& x2
     }
     return acc;
 }
+template< class Vector1, class Vector2>
+std::vector<int64_t> doDot_superacc_batch( const std::vector<const Vector1*>& x, const std::vector<const Vector2*>& y, RecursiveVectorTag)
+{
+    unsigned num = x.size();
+    auto size = x[0]->size();
+    std::vector<int64_t> acc( num*exblas::BIN_COUNT, (int64_t)0);
+    std::vector<const typename Vector1::value_type*> x_elem( num);
+    std::vector<const typename Vector2::value_type*> y_elem( num);
+    for( unsigned i=0; i<size; i++)
+    {
+        for( unsigned k=0; k<num; k++)
+        {
+            x_elem[k] = &(*x[k])[i];
+            y_elem[k] = &(*y[k])[i];
+        }
+        std::vector<int64_t> temp = doDot_superacc_batch( x_elem, y_elem);
+        for( unsigned k=0; k<num; k++)
+        {
+            int imin = exblas::IMIN, imax = exblas::IMAX;
+            exblas::cpu::Normalize( &(temp[k*exblas::BIN_COUNT]), imin, imax);
+            for( int l=exblas::IMIN; l<=exblas::IMAX; l++)
+                acc[k*exblas::BIN_COUNT+l] += temp[k*exblas::BIN_COUNT+l];
+            if( (i+1)%128 == 0)
+            {
+                imin = exblas::IMIN, imax = exblas::IMAX;
+                exblas::cpu::Normalize( &(acc[k*exblas::BIN_COUNT]), imin, imax);
+            }
+        }
+    }
+    return acc;
+}
 /////////////////////////////////////////////////////////////////////////////////////
 #ifdef _OPENMP
 //omp tag implementation
@@ -5,6 +5,7 @@
 #include <thrust/system/omp/execution_policy.h>
 #include "config.h"
 #include "blas1_serial.h"
+#include "parallel_session.h"
 #include "exblas/exdot_omp.h"
 namespace dg
 {
@@ -14,8 +15,115 @@ namespace detail
 {
 const int MIN_SIZE=100;//don't parallelize if work is too small
 
+template<class T>
+inline T get_offset( T x, int i){
+	return x;
+}
+template<class T>
+inline T* get_offset( T* x, int i){
+	return x+i;
+}
+
+//Inside a parallel session every thread computes the num (normalized)
+//superaccumulators of its range with status = local( begin, end, acc) and all
+//threads return the exact sum of all ranges
+//(the status of all threads is shared, so that either all or no thread throws)
+template<class LocalDot>
+std::vector<int64_t> doDot_session( unsigned size, unsigned num, LocalDot local)
+{
+    static thread_local std::vector<int64_t> partial;
+    partial.resize( num*exblas::BIN_COUNT);
+    std::vector<const int64_t*>& pointers = dg::detail::parallel_session_pointers();
+    std::vector<int>& status = dg::detail::parallel_session_status();
+    int tid = omp_get_thread_num(), tnum = omp_get_num_threads();
+    int begin = (tid*(int64_t)size)/tnum, end = ((tid+1)*(int64_t)size)/tnum;
+    status[tid] = local( begin, end, &partial[0]);
+    for( unsigned k=0; k<num; k++)
+    {
+        int imin = exblas::IMIN, imax = exblas::IMAX;
+        exblas::cpu::Normalize( &partial[k*exblas::BIN_COUNT], imin, imax);
+    }
+    pointers[tid] = &partial[0];
+    #pragma omp barrier
+    std::vector<int64_t> acc( num*exblas::BIN_COUNT, 0);
+    int failed = 0;
+    for( int t=0; t<tnum; t++)
+    {
+        failed |= status[t];
+        for( unsigned i=0; i<num*exblas::BIN_COUNT; i++)
+            acc[i] += pointers[t][i];
+        if( (t+1)%128 == 0)
+            for( unsigned k=0; k<num; k++)
+            {
+                int imin = exblas::IMIN, imax = exblas::IMAX;
+                exblas::cpu::Normalize( &acc[k*exblas::BIN_COUNT], imin, imax);
+            }
+    }
+    #pragma omp barrier
+    //all threads throw here, dg::parallel_session rethrows after the region
+    if( failed != 0)
+        throw dg::Error(dg::Message(_ping_)<<"OMP Dot failed since one of the inputs contains NaN or Inf");
+    return acc;
+}
+//the superaccumulator of a range for either reduction policy
+//@return non-zero status if one of the inputs contains NaN or Inf
+template<class Product, class PointerOrValue1, class PointerOrValue2, class PointerOrValue3>
+int local_dot( int begin, int end, Product f, int64_t* acc, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr, PointerOrValue3 z_ptr)
+{
+    int status = 0;
+    if( get_reduction_policy() == ReductionPolicy::fast)
+    {
+        double sum, err;
+        compensated_sum( begin, end, f, sum, err);
+        accumulate_partial_sums( 1, &sum, &err, acc);
+    }
+    else
+        exblas::exdot_cpu( end-begin, get_offset( x_ptr, begin),
+            get_offset( y_ptr, begin), get_offset( z_ptr, begin), acc, &status);
+    return status;
+}
+template<class Product, class PointerOrValue1, class PointerOrValue2>
+int local_dot( int begin, int end, Product f, int64_t* acc, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr)
+{
+    int status = 0;
+    if( get_reduction_policy() == ReductionPolicy::fast)
+    {
+        double sum, err;
+        compensated_sum( begin, end, f, sum, err);
+        accumulate_partial_sums( 1, &sum, &err, acc);
+    }
+    else
+        exblas::exdot_cpu( end-begin, get_offset( x_ptr, begin),
+            get_offset( y_ptr, begin), acc, &status);
+    return status;
+}
+
+//every thread sums its static range, the partial sums are added exactly
+template<class Product>
+inline std::vector<int64_t> doDot_fast_dispatch( OmpTag, unsigned size, Product f) {
+    if(size<MIN_SIZE)
+        return doDot_fast_dispatch( SerialTag(), size, f);
+    std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
+    int maxthreads = omp_get_max_threads();
+    std::vector<double> sum( maxthreads, 0.), err( maxthreads, 0.);
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num(), tnum = omp_get_num_threads();
+        int begin = (tid*(int64_t)size)/tnum, end = ((tid+1)*(int64_t)size)/tnum;
+        compensated_sum( begin, end, f, sum[tid], err[tid]);
+    }
+    accumulate_partial_sums( maxthreads, &sum[0], &err[0], &h_superacc[0]);
+    return h_superacc;
+}
+
 template<class PointerOrValue1, class PointerOrValue2>
 inline std::vector<int64_t> doDot_dispatch( OmpTag, unsigned size, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr) {
+    if( dg::detail::in_parallel_session())
+        return doDot_session( size, 1, [&]( int begin, int end, int64_t* acc){
+            return local_dot( begin, end, DotProduct<PointerOrValue1, PointerOrValue2>{x_ptr, y_ptr}, acc, x_ptr, y_ptr);
+        });
+    if( get_reduction_policy() == ReductionPolicy::fast)
+        return doDot_fast_dispatch( OmpTag(), size, DotProduct<PointerOrValue1, PointerOrValue2>{x_ptr, y_ptr});
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
     int status = 0;
     if(size<MIN_SIZE)
@@ -28,6 +136,12 @@ inline std::vector<int64_t> doDot_dispatch( OmpTag, unsigned size, PointerOrValu
 }
 template<class PointerOrValue1, class PointerOrValue2, class PointerOrValue3>
 inline std::vector<int64_t> doDot_dispatch( OmpTag, unsigned size, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr, PointerOrValue3 z_ptr) {
+    if( dg::detail::in_parallel_session())
+        return doDot_session( size, 1, [&]( int begin, int end, int64_t* acc){
+            return local_dot( begin, end, TripleDotProduct<PointerOrValue1, PointerOrValue2, PointerOrValue3>{x_ptr, y_ptr, z_ptr}, acc, x_ptr, y_ptr, z_ptr);
+        });
+    if( get_reduction_policy() == ReductionPolicy::fast)
+        return doDot_fast_dispatch( OmpTag(), size, TripleDotProduct<PointerOrValue1, PointerOrValue2, PointerOrValue3>{x_ptr, y_ptr, z_ptr});
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
     int status = 0;
     if(size<MIN_SIZE)
@@ -38,6 +152,34 @@ inline std::vector<int64_t> doDot_dispatch( OmpTag, unsigned size, PointerOrValu
         throw dg::Error(dg::Message(_ping_)<<"OMP Dot failed since one of the inputs contains NaN or Inf");
     return h_superacc;
 }
+template<class T1, class T2>
+inline std::vector<int64_t> doDot_batch_dispatch( OmpTag, unsigned size, unsigned num, const T1* const* x_ptrs, const T2* const* y_ptrs) {
+    if( dg::detail::in_parallel_session())
+        return doDot_session( size, num, [&]( int begin, int end, int64_t* acc){
+            int status = 0;
+            for( unsigned k=0; k<num; k++)
+                status |= local_dot( begin, end, DotProduct<const T1*, const T2*>{x_ptrs[k], y_ptrs[k]}, &acc[k*exblas::BIN_COUNT], x_ptrs[k], y_ptrs[k]);
+            return status;
+        });
+    std::vector<int64_t> h_superacc(num*exblas::BIN_COUNT);
+    if( get_reduction_policy() == ReductionPolicy::fast)
+    {
+        for( unsigned k=0; k<num; k++)
+        {
+            std::vector<int64_t> acc = doDot_fast_dispatch( OmpTag(), size, DotProduct<const T1*, const T2*>{x_ptrs[k], y_ptrs[k]});
+            std::copy( acc.begin(), acc.end(), h_superacc.begin()+k*exblas::BIN_COUNT);
+        }
+        return h_superacc;
+    }
+    int status = 0;
+    if(size<MIN_SIZE)
+        exblas::exdot_batch_cpu( size, num, x_ptrs, y_ptrs, &h_superacc[0], &status);
+    else
+        exblas::exdot_batch_omp( size, num, x_ptrs, y_ptrs, &h_superacc[0], &status);
+    if(status != 0)
+        throw dg::Error(dg::Message(_ping_)<<"OMP Dot failed since one of the inputs contains NaN or Inf");
+    return h_superacc;
+}
 
 template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
 inline void doSubroutine_omp( int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
@@ -55,6 +197,7 @@ inline void doSubroutine_dispatch( OmpTag, int size, Subroutine f, PointerOrValu
     if(omp_in_parallel())
     {
         doSubroutine_omp( size, f, x, xs... );
+        dg::detail::parallel_session_barrier();
         return;
     }
     if(size>MIN_SIZE)
@@ -1,9 +1,13 @@
 #ifndef _DG_BLAS_SERIAL_
 #define _DG_BLAS_SERIAL_
+#include <algorithm>
+#include <cmath>
+#include <cassert>
 #include "config.h"
 #include "exceptions.h"
 #include "execution_policy.h"
 #include "exblas/exdot_serial.h"
+#include "parallel_session.h"
 
 namespace dg
 {
@@ -11,8 +15,88 @@ namespace blas1
 {
 namespace detail
 {
+template<class T>
+inline T get_element( T x, int i){
+	return x;
+}
+template<class T>
+inline T& get_element( T* x, int i){
+	return *(x+i);
+}
+
+//////////////////////fast (compensated) summation/////////////////////////////
+//Knuth's TwoSum: s+c += x with the rounding error accumulated in c
+inline void two_sum( double& s, double x, double& c)
+{
+    double t = s + x;
+    double bp = t - s;
+    c += (s - (t - bp)) + (x - bp);
+    s = t;
+}
+template<class PointerOrValue1, class PointerOrValue2>
+struct DotProduct
+{
+    PointerOrValue1 x;
+    PointerOrValue2 y;
+    double operator()( int i) const{
+        return (double)get_element(x,i)*(double)get_element(y,i);
+    }
+};
+template<class PointerOrValue1, class PointerOrValue2, class PointerOrValue3>
+struct TripleDotProduct
+{
+    PointerOrValue1 x;
+    PointerOrValue2 y;
+    PointerOrValue3 z;
+    double operator()( int i) const{
+        return (double)get_element(x,i)*(double)get_element(y,i)*(double)get_element(z,i);
+    }
+};
+//compensated sum of f(i) for i in [begin,end) in independent lanes
+template<class Product>
+void compensated_sum( int begin, int end, Product f, double& sum, double& err)
+{
+    constexpr int lanes = 8;
+    double s[lanes] = {0}, c[lanes] = {0};
+    int i = begin;
+    for( ; i+lanes <= end; i+=lanes)
+        for( int l=0; l<lanes; l++)
+            two_sum( s[l], f(i+l), c[l]);
+    for( ; i<end; i++)
+        two_sum( s[0], f(i), c[0]);
+    sum = 0, err = 0;
+    for( int l=0; l<lanes; l++)
+    {
+        two_sum( sum, s[l], err);
+        err += c[l];
+    }
+}
+//the partial sums are added exactly to the superaccumulator
+inline void accumulate_partial_sums( unsigned num, const double* sum, const double* err, int64_t* h_superacc)
+{
+    for( int i=0; i<exblas::BIN_COUNT; i++)
+        h_superacc[i] = 0;
+    for( unsigned k=0; k<num; k++)
+    {
+        if( !std::isfinite( sum[k]) || !std::isfinite( err[k]))
+            throw dg::Error(dg::Message(_ping_)<<"Dot failed since one of the inputs contains NaN or Inf");
+        exblas::cpu::Accumulate( h_superacc, sum[k]);
+        exblas::cpu::Accumulate( h_superacc, err[k]);
+    }
+}
+template<class Product>
+inline std::vector<int64_t> doDot_fast_dispatch( SerialTag, unsigned size, Product f) {
+    std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
+    double sum, err;
+    compensated_sum( 0, size, f, sum, err);
+    accumulate_partial_sums( 1, &sum, &err, &h_superacc[0]);
+    return h_superacc;
+}
+///////////////////////////////////////////////////////////////////////////////
 template<class PointerOrValue1, class PointerOrValue2>
 inline std::vector<int64_t> doDot_dispatch( SerialTag, unsigned size, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr) {
+    if( get_reduction_policy() == ReductionPolicy::fast)
+        return doDot_fast_dispatch( SerialTag(), size, DotProduct<PointerOrValue1, PointerOrValue2>{x_ptr, y_ptr});
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
     int status = 0;
     exblas::exdot_cpu( size, x_ptr,y_ptr, &h_superacc[0],&status) ;
@@ -22,6 +106,8 @@ inline std::vector<int64_t> doDot_dispatch( SerialTag, unsigned size, PointerOrV
 }
 template<class PointerOrValue1, class PointerOrValue2, class PointerOrValue3>
 inline std::vector<int64_t> doDot_dispatch( SerialTag, unsigned size, PointerOrValue1 x_ptr, PointerOrValue2 y_ptr, PointerOrValue3 z_ptr) {
+    if( get_reduction_policy() == ReductionPolicy::fast)
+        return doDot_fast_dispatch( SerialTag(), size, TripleDotProduct<PointerOrValue1, PointerOrValue2, PointerOrValue3>{x_ptr, y_ptr, z_ptr});
     std::vector<int64_t> h_superacc(exblas::BIN_COUNT);
     int status = 0;
     exblas::exdot_cpu( size, x_ptr,y_ptr,z_ptr, &h_superacc[0], &status) ;
@@ -29,18 +115,30 @@ inline std::vector<int64_t> doDot_dispatch( SerialTag, unsigned size, PointerOrV
         throw dg::Error(dg::Message(_ping_)<<"CPU Dot failed since one of the inputs contains NaN or Inf");
     return h_superacc;
 }
-
-template<class T>
-inline T get_element( T x, int i){
-	return x;
-}
-template<class T>
-inline T& get_element( T* x, int i){
-	return *(x+i);
+template<class T1, class T2>
+inline std::vector<int64_t> doDot_batch_dispatch( SerialTag, unsigned size, unsigned num, const T1* const* x_ptrs, const T2* const* y_ptrs) {
+    std::vector<int64_t> h_superacc(num*exblas::BIN_COUNT);
+    if( get_reduction_policy() == ReductionPolicy::fast)
+    {
+        for( unsigned k=0; k<num; k++)
+        {
+            std::vector<int64_t> acc = doDot_fast_dispatch( SerialTag(), size, DotProduct<const T1*, const T2*>{x_ptrs[k], y_ptrs[k]});
+            std::copy( acc.begin(), acc.end(), h_superacc.begin()+k*exblas::BIN_COUNT);
+        }
+        return h_superacc;
+    }
+    int status = 0;
+    exblas::exdot_batch_cpu( size, num, x_ptrs, y_ptrs, &h_superacc[0], &status) ;
+    if(status != 0)
+        throw dg::Error(dg::Message(_ping_)<<"CPU Dot failed since one of the inputs contains NaN or Inf");
+    return h_superacc;
 }
+
 template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
 inline void doSubroutine_dispatch( SerialTag, int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
 {
+    //every thread of a session would write the output again
+    assert( !dg::detail::in_parallel_session() && "Host vectors are not allowed in a dg::parallel_session");
     for( int i=0; i<size; i++)
     {
         f(get_element(x,i), get_element(xs,i)...);
@@ -13,6 +13,7 @@
 
 #include "config.h"
 #include "tensor_traits.h"
+#include "parallel_session.h"
 
 ///@cond
 namespace dg{
@@ -29,6 +30,24 @@ inline void doTransfer( const Matrix1& x, Matrix2& y, CuspMatrixTag, CuspMatrixT
 
 
 #ifdef _OPENMP
+template<class value_type, class index_type>
+inline void doSymv_csr_omp( int rows, const value_type* RESTRICT val_ptr,
+    const index_type* RESTRICT row_ptr, const index_type* RESTRICT col_ptr,
+    const value_type* RESTRICT x_ptr, value_type* RESTRICT y_ptr)
+{
+    #pragma omp for nowait
+    for(int i = 0; i < rows; i++)
+    {
+        value_type temp = 0.;
+        for (index_type jj = row_ptr[i]; jj < row_ptr[i+1]; jj++)
+        {
+            index_type j = col_ptr[jj];
+            temp = DG_FMA( val_ptr[jj], x_ptr[j], temp);
+        }
+
+        y_ptr[i] = temp;
+    }
+}
 template< class Matrix, class Container1, class Container2>
 inline void doSymv_cusp_dispatch( Matrix&& m,
                     const Container1& x,
@@ -44,17 +63,15 @@ inline void doSymv_cusp_dispatch( Matrix&& m,
     const value_type* RESTRICT x_ptr = thrust::raw_pointer_cast( x.data());
     value_type* RESTRICT y_ptr = thrust::raw_pointer_cast( y.data());
     int rows = m.num_rows;
-    #pragma omp parallel for
-    for(int i = 0; i < rows; i++)
+    if( dg::detail::in_parallel_session())
     {
-        value_type temp = 0.;
-        for (index_type jj = row_ptr[i]; jj < row_ptr[i+1]; jj++)
-        {
-            index_type j = col_ptr[jj];
-            temp = DG_FMA( val_ptr[jj], x_ptr[j], temp);
-        }
-
-        y_ptr[i] = temp;
+        doSymv_csr_omp( rows, val_ptr, row_ptr, col_ptr, x_ptr, y_ptr);
+        #pragma omp barrier
+        return;
+    }
+    #pragma omp parallel
+    {
+        doSymv_csr_omp( rows, val_ptr, row_ptr, col_ptr, x_ptr, y_ptr);
     }
 }
 #endif// _OPENMP
@@ -47,6 +47,27 @@ inline std::vector<int64_t> doDot_superacc( const Vector1& x, const Matrix& m, c
 
     return receive;
 }
+//local computations only, the superaccumulator still needs to be reduced among processes
+template< class Vector1, class Matrix, class Vector2 >
+inline std::vector<int64_t> doDot_superacc_local( const Vector1& x, const Matrix& m, const Vector2& y, AnyScalarTag, MPIVectorTag)
+{
+#ifdef DG_DEBUG
+    dg::blas1::detail::mpi_assert( x,y);
+#endif //DG_DEBUG
+    return doDot_superacc( do_get_data(x, get_tensor_category<Vector1>()), m, do_get_data(y, get_tensor_category<Vector2>()));
+}
+template< class Vector1, class Matrix, class Vector2 >
+inline std::vector<int64_t> doDot_superacc_local( const Vector1& x, const Matrix& m, const Vector2& y, MPIVectorTag, MPIVectorTag)
+{
+#ifdef DG_DEBUG
+    dg::blas1::detail::mpi_assert( m,x);
+    dg::blas1::detail::mpi_assert( m,y);
+#endif //DG_DEBUG
+    return doDot_superacc(
+        do_get_data(x, get_tensor_category<Vector1>()),
+        m.data(),
+        do_get_data(y, get_tensor_category<Vector2>()));
+}
 template< class Vector1, class Matrix, class Vector2>
 inline std::vector<int64_t> doDot_superacc( const Vector1& x, const Matrix& m, const Vector2& y, MPIVectorTag, RecursiveVectorTag)
 {
@@ -155,6 +176,51 @@ inline void doSymv( get_value_type<Vector1> alpha,
         dg::blas2::symv( alpha, std::forward<Matrix>(m), x[i], beta, y[i]);
 }
 
+//several RowColDistMat: all halo exchanges are in flight while the inner points are computed
+template< class LI, class LO, class C, class Vector1, class Vector2>
+inline void doSymv_batch_mpi( const std::vector<const RowColDistMat<LI,LO,C>*>& m, const Vector1& x, const std::vector<Vector2*>& y)
+{
+    std::vector<MPI_Request> rqst( 4*m.size(), MPI_REQUEST_NULL);
+    for( unsigned i=0; i<m.size(); i++)
+        if( m[i]->collective().isCommunicating())
+            m[i]->symv_start( x, &rqst[4*i]);
+    for( unsigned i=0; i<m.size(); i++)
+        dg::blas2::symv( m[i]->inner_matrix(), x.data(), y[i]->data());
+    for( unsigned i=0; i<m.size(); i++)
+        if( m[i]->collective().isCommunicating())
+            m[i]->symv_finish( 1., x, *y[i], &rqst[4*i]);
+}
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch_mpi( const std::vector<const Matrix*>& m, const Vector1& x, const std::vector<Vector2*>& y)
+{
+    for( unsigned i=0; i<m.size(); i++)
+        dg::blas2::symv( *m[i], x, *y[i]);
+}
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch( const std::vector<const Matrix*>& m, const Vector1& x, const std::vector<Vector2*>& y, MPIMatrixTag, MPIVectorTag)
+{
+#ifdef DG_DEBUG
+    for( unsigned i=0; i<m.size(); i++)
+        dg::blas1::detail::mpi_assert( x, *y[i]);
+#endif //DG_DEBUG
+    doSymv_batch_mpi( m, x, y);
+}
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch( const std::vector<const Matrix*>& m, const Vector1& x, const std::vector<Vector2*>& y, MPIMatrixTag, RecursiveVectorTag)
+{
+    for( unsigned k=0; k<x.size(); k++)
+    {
+        std::vector<std::decay_t<decltype( (*y[0])[k])>*> yk( y.size());
+        for( unsigned i=0; i<y.size(); i++)
+            yk[i] = &(*y[i])[k];
+        doSymv_batch( m, x[k], yk, MPIMatrixTag(), get_tensor_category<std::decay_t<decltype(x[k])>>());
+    }
+}
+template< class Matrix, class Vector1, class Vector2>
+inline void doSymv_batch( const std::vector<const Matrix*>& m, const Vector1& x, const std::vector<Vector2*>& y, MPIMatrixTag)
+{
+    doSymv_batch( m, x, y, MPIMatrixTag(), get_tensor_category<Vector1>());
+}
 
 } //namespace detail
 } //namespace blas2
@@ -65,6 +65,13 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Matrix& m, const Ve
     return dg::blas1::detail::doDot_dispatch( execution_policy(), m.size(), do_get_pointer_or_reference(x,get_tensor_category<Vector1>()), do_get_pointer_or_reference(m,get_tensor_category<Matrix>()), do_get_pointer_or_reference(y,get_tensor_category<Vector2>()));
 }
 
+//the local part of a dot product is the dot product unless the vectors are distributed among processes
+template< class Vector1, class Matrix, class Vector2, class MatrixTag, class VectorTag>
+inline std::vector<int64_t> doDot_superacc_local( const Vector1& x, const Matrix& m, const Vector2& y, MatrixTag, VectorTag)
+{
+    return doDot_superacc( x, m, y);
+}
+
 template< class Vector1, class Matrix, class Vector2>
 inline std::vector<int64_t> doDot_superacc( const Vector1& x, const Matrix& m, const Vector2& y, SharedVectorTag, RecursiveVectorTag)
 {
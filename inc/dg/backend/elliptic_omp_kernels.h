@@ -0,0 +1,381 @@
+#pragma once
+
+#include <omp.h>
+#include <vector>
+#include "config.h"
+#include "sparseblockmat.cuh"
+
+//for the fmas it is important to activate -mfma compiler flag
+
+namespace dg{
+///@cond
+namespace detail{
+
+//raw pointers into a EllSparseBlockMatDevice
+template<class value_type>
+struct EllView
+{
+    EllView( const EllSparseBlockMatDevice<value_type>& m):
+        data( thrust::raw_pointer_cast( m.data.data())),
+        cols_idx( thrust::raw_pointer_cast( m.cols_idx.data())),
+        data_idx( thrust::raw_pointer_cast( m.data_idx.data())),
+        bpl( m.blocks_per_line){}
+    const value_type* data;
+    const int* cols_idx;
+    const int* data_idx;
+    int bpl;
+};
+
+// Compute the product chi*grad(x) for all n rows of y-block row J in plane s
+// gx and gy are of size n*M, tx and ty of size M
+// The order of operations per element is exactly the one of the unfused
+// dg::Elliptic::symv (symv with beta=0 and TensorMultiply2d with mu=0)
+template<class value_type, int n>
+void fused_elliptic2d_gradient( int s, int J, int Nx, int Ny,
+    EllView<value_type> rx, EllView<value_type> ry,
+    const value_type* RESTRICT sigma,
+    const value_type* RESTRICT t00, const value_type* RESTRICT t01,
+    const value_type* RESTRICT t10, const value_type* RESTRICT t11,
+    const value_type* RESTRICT x,
+    value_type* RESTRICT tx, value_type* RESTRICT ty,
+    value_type* RESTRICT gx, value_type* RESTRICT gy)
+{
+    const int M = Nx*n;
+    for( int kk=0; kk<n; kk++)
+    {
+        const int r = (s*Ny+J)*n+kk;
+        const value_type* RESTRICT xr = &x[r*M];
+        //R_x*f
+        for( int ix=0; ix<Nx; ix++)
+        for( int k=0; k<n; k++)
+        {
+            value_type t = 0;
+            for( int d=0; d<rx.bpl; d++)
+            {
+                int C = rx.cols_idx[ix*rx.bpl+d]*n;
+                int B = (rx.data_idx[ix*rx.bpl+d]*n+k)*n;
+                value_type temp = 0;
+                for( int q=0; q<n; q++) //multiplication-loop
+                    temp = DG_FMA( rx.data[B+q], xr[C+q], temp);
+                t = DG_FMA( (value_type)1, temp, t);
+            }
+            tx[ix*n+k] = t;
+        }
+        //R_y*f
+        for( int j=0; j<M; j++)
+            ty[j] = 0;
+        for( int d=0; d<ry.bpl; d++)
+        {
+            int C = (s*Ny+ry.cols_idx[J*ry.bpl+d])*n;
+            int B = (ry.data_idx[J*ry.bpl+d]*n+kk)*n;
+            #ifndef _MSC_VER
+            #pragma omp SIMD
+            #endif
+            for( int j=0; j<M; j++)
+            {
+                value_type temp = 0;
+                for( int q=0; q<n; q++) //multiplication-loop
+                    temp = DG_FMA( ry.data[B+q], x[(C+q)*M+j], temp);
+                ty[j] = DG_FMA( (value_type)1, temp, ty[j]);
+            }
+        }
+        //multiply with tensor
+        #ifndef _MSC_VER
+        #pragma omp SIMD
+        #endif
+        for( int j=0; j<M; j++)
+        {
+            const int I = r*M+j;
+            value_type tmp0 = DG_FMA(t00[I], tx[j], t01[I]*ty[j]);
+            value_type tmp1 = DG_FMA(t10[I], tx[j], t11[I]*ty[j]);
+            value_type temp = ty[j]*(value_type)0;
+            gy[kk*M+j] = DG_FMA( sigma[I], tmp1, temp);
+            temp = tx[j]*(value_type)0;
+            gx[kk*M+j] = DG_FMA( sigma[I], tmp0, temp);
+        }
+    }
+}
+
+//Temporaries of the fused kernel, one set per thread, allocated once and
+//reused in every call (the kernel runs in every matrix-vector product)
+template<class value_type>
+struct FusedEllipticWorkspace
+{
+    struct Thread
+    {
+        std::vector<value_type> gx, gy, tx, ty, t;
+        std::vector<int> tag, needed, where;
+    };
+    //can threads threads use the workspace for the given sizes
+    bool fits( int threads, int slots, int n, int M) const{
+        return threads <= (int)m_threads.size() && slots == m_slots
+            && n == m_n && M == m_M;
+    }
+    //not thread safe
+    void resize( int threads, int slots, int n, int M){
+        m_slots = slots, m_n = n, m_M = M;
+        m_threads.resize( threads);
+        for( auto& w : m_threads)
+        {
+            w.gx.resize( slots*n*M), w.gy.resize( slots*n*M);
+            w.tx.resize( M), w.ty.resize( M), w.t.resize( M);
+            w.tag.resize( slots), w.needed.resize( slots), w.where.resize( slots);
+        }
+    }
+    Thread& thread( int tid){ return m_threads[tid];}
+    private:
+    std::vector<Thread> m_threads;
+    int m_slots = 0, m_n = 0, m_M = 0;
+};
+
+// y = alpha W ( -L_x gx - L_y gy + jfactor (J_x + J_y) x) + beta y
+// for all y-block rows; gradient rows are cached per thread in a small ring
+// of slots such that each one is computed (almost) only once
+template<class value_type, int n>
+void fused_elliptic2d_kernel( value_type alpha, value_type beta,
+    const EllSparseBlockMatDevice<value_type>& rightx,
+    const EllSparseBlockMatDevice<value_type>& righty,
+    const EllSparseBlockMatDevice<value_type>& leftx,
+    const EllSparseBlockMatDevice<value_type>& lefty,
+    const EllSparseBlockMatDevice<value_type>& jumpX,
+    const EllSparseBlockMatDevice<value_type>& jumpY,
+    value_type jfactor,
+    const value_type* RESTRICT sigma,
+    const value_type* RESTRICT t00, const value_type* RESTRICT t01,
+    const value_type* RESTRICT t10, const value_type* RESTRICT t11,
+    const value_type* RESTRICT weights, bool normed,
+    const value_type* RESTRICT x, value_type* RESTRICT y,
+    FusedEllipticWorkspace<value_type>& ws)
+{
+    const int Nx = rightx.num_rows, Ny = righty.num_rows;
+    const int Nz = righty.left_size, M = Nx*n;
+    EllView<value_type> rx(rightx), ry(righty), lx(leftx), ly(lefty),
+        jx(jumpX), jy(jumpY);
+    //static schedule over all y-block rows of all planes
+    const int tid = omp_get_thread_num(), nt = omp_get_num_threads();
+    const int items = Nz*Ny;
+    const int begin = (items*(long)tid)/nt, end = (items*(long)(tid+1))/nt;
+    if( begin >= end)
+        return;
+    const int slots = ly.bpl+1;
+    typename FusedEllipticWorkspace<value_type>::Thread& w = ws.thread( tid);
+    value_type* RESTRICT gx = w.gx.data();
+    value_type* RESTRICT gy = w.gy.data();
+    value_type* RESTRICT t = w.t.data();
+    int* tag = w.tag.data();
+    int* needed = w.needed.data();
+    int* where = w.where.data();
+    //the cached gradient rows belong to the previous x
+    for( int l=0; l<slots; l++)
+        tag[l] = -1;
+    for( int sI=begin; sI<end; sI++)
+    {
+        const int s = sI/Ny, I = sI%Ny;
+        for( int d=0; d<ly.bpl; d++)
+            needed[d] = s*Ny+ly.cols_idx[I*ly.bpl+d];
+        needed[ly.bpl] = sI;
+        //look up or compute gradient rows
+        for( int m=0; m<slots; m++)
+        {
+            where[m] = -1;
+            for( int l=0; l<slots; l++)
+                if( tag[l] == needed[m])
+                    where[m] = l;
+        }
+        for( int m=0; m<slots; m++)
+        {
+            if( where[m] != -1)
+                continue;
+            //find a slot that is not needed by this row
+            int victim = 0;
+            for( int l=0; l<slots; l++)
+            {
+                bool used = false;
+                for( int o=0; o<slots; o++)
+                    if( where[o] == l)
+                        used = true;
+                if( !used)
+                {
+                    victim = l;
+                    break;
+                }
+            }
+            fused_elliptic2d_gradient<value_type, n>( s, needed[m]%Ny, Nx, Ny, rx, ry,
+                sigma, t00, t01, t10, t11, x, w.tx.data(), w.ty.data(),
+                &gx[victim*n*M], &gy[victim*n*M]);
+            tag[victim] = needed[m];
+            for( int o=m; o<slots; o++)
+                if( needed[o] == needed[m])
+                    where[o] = victim;
+        }
+        //now take divergence and add jumps
+        for( int kk=0; kk<n; kk++)
+        {
+            const int r = sI*n+kk;
+            //symv( L_y, gy, t)
+            for( int j=0; j<M; j++)
+                t[j] = 0;
+            for( int d=0; d<ly.bpl; d++)
+            {
+                const value_type* RESTRICT gyJ = &gy[where[d]*n*M];
+                int B = (ly.data_idx[I*ly.bpl+d]*n+kk)*n;
+                #ifndef _MSC_VER
+                #pragma omp SIMD
+                #endif
+                for( int j=0; j<M; j++)
+                {
+                    value_type temp = 0;
+                    for( int q=0; q<n; q++) //multiplication-loop
+                        temp = DG_FMA( ly.data[B+q], gyJ[q*M+j], temp);
+                    t[j] = DG_FMA( (value_type)1, temp, t[j]);
+                }
+            }
+            //symv( -1, L_x, gx, -1, t)
+            const value_type* RESTRICT gxI = &gx[where[ly.bpl]*n*M + kk*M];
+            for( int ix=0; ix<Nx; ix++)
+            for( int k=0; k<n; k++)
+            {
+                value_type tt = -t[ix*n+k];
+                for( int d=0; d<lx.bpl; d++)
+                {
+                    int C = lx.cols_idx[ix*lx.bpl+d]*n;
+                    int B = (lx.data_idx[ix*lx.bpl+d]*n+k)*n;
+                    value_type temp = 0;
+                    for( int q=0; q<n; q++) //multiplication-loop
+                        temp = DG_FMA( lx.data[B+q], gxI[C+q], temp);
+                    tt = DG_FMA( (value_type)-1, temp, tt);
+                }
+                t[ix*n+k] = tt;
+            }
+            //add jump terms
+            if( 0.0 != jfactor)
+            {
+                const value_type* RESTRICT xr = &x[r*M];
+                for( int ix=0; ix<Nx; ix++)
+                for( int k=0; k<n; k++)
+                {
+                    value_type tt = t[ix*n+k];
+                    for( int d=0; d<jx.bpl; d++)
+                    {
+                        int C = jx.cols_idx[ix*jx.bpl+d]*n;
+                        int B = (jx.data_idx[ix*jx.bpl+d]*n+k)*n;
+                        value_type temp = 0;
+                        for( int q=0; q<n; q++) //multiplication-loop
+                            temp = DG_FMA( jx.data[B+q], xr[C+q], temp);
+                        tt = DG_FMA( jfactor, temp, tt);
+                    }
+                    t[ix*n+k] = tt;
+                }
+                for( int d=0; d<jy.bpl; d++)
+                {
+                    int C = (s*Ny+jy.cols_idx[I*jy.bpl+d])*n;
+                    int B = (jy.data_idx[I*jy.bpl+d]*n+kk)*n;
+                    #ifndef _MSC_VER
+                    #pragma omp SIMD
+                    #endif
+                    for( int j=0; j<M; j++)
+                    {
+                        value_type temp = 0;
+                        for( int q=0; q<n; q++) //multiplication-loop
+                            temp = DG_FMA( jy.data[B+q], x[(C+q)*M+j], temp);
+                        t[j] = DG_FMA( jfactor, temp, t[j]);
+                    }
+                }
+            }
+            //multiply weights
+            value_type* RESTRICT yr = &y[r*M];
+            const value_type* RESTRICT wr = &weights[r*M];
+            if( normed)
+            {
+                #ifndef _MSC_VER
+                #pragma omp SIMD
+                #endif
+                for( int j=0; j<M; j++)
+                {
+                    value_type temp = yr[j]*beta;
+                    yr[j] = DG_FMA( alpha, t[j]/wr[j], temp);
+                }
+            }
+            else
+            {
+                #ifndef _MSC_VER
+                #pragma omp SIMD
+                #endif
+                for( int j=0; j<M; j++)
+                {
+                    value_type temp = yr[j]*beta;
+                    yr[j] = DG_FMA( alpha*wr[j], t[j], temp);
+                }
+            }
+        }
+    }
+}
+
+template<class value_type>
+void launch_fused_elliptic2d_kernel( value_type alpha, value_type beta,
+    const EllSparseBlockMatDevice<value_type>& rightx,
+    const EllSparseBlockMatDevice<value_type>& righty,
+    const EllSparseBlockMatDevice<value_type>& leftx,
+    const EllSparseBlockMatDevice<value_type>& lefty,
+    const EllSparseBlockMatDevice<value_type>& jumpX,
+    const EllSparseBlockMatDevice<value_type>& jumpY,
+    value_type jfactor,
+    const value_type* sigma,
+    const value_type* t00, const value_type* t01,
+    const value_type* t10, const value_type* t11,
+    const value_type* weights, bool normed,
+    const value_type* x, value_type* y,
+    FusedEllipticWorkspace<value_type>& ws)
+{
+    if( righty.n == 1)
+        fused_elliptic2d_kernel<value_type, 1>( alpha, beta, rightx, righty,
+            leftx, lefty, jumpX, jumpY, jfactor, sigma, t00, t01, t10, t11,
+            weights, normed, x, y, ws);
+    else if( righty.n == 2)
+        fused_elliptic2d_kernel<value_type, 2>( alpha, beta, rightx, righty,
+            leftx, lefty, jumpX, jumpY, jfactor, sigma, t00, t01, t10, t11,
+            weights, normed, x, y, ws);
+    else if( righty.n == 3)
+        fused_elliptic2d_kernel<value_type, 3>( alpha, beta, rightx, righty,
+            leftx, lefty, jumpX, jumpY, jfactor, sigma, t00, t01, t10, t11,
+            weights, normed, x, y, ws);
+    else if( righty.n == 4)
+        fused_elliptic2d_kernel<value_type, 4>( alpha, beta, rightx, righty,
+            leftx, lefty, jumpX, jumpY, jfactor, sigma, t00, t01, t10, t11,
+            weights, normed, x, y, ws);
+    else if( righty.n == 5)
+        fused_elliptic2d_kernel<value_type, 5>( alpha, beta, rightx, righty,
+            leftx, lefty, jumpX, jumpY, jfactor, sigma, t00, t01, t10, t11,
+            weights, normed, x, y, ws);
+}
+
+//check if the fused kernel can be applied to the given derivatives
+template<class value_type>
+bool fused_elliptic2d_applicable(
+    const EllSparseBlockMatDevice<value_type>& rightx,
+    const EllSparseBlockMatDevice<value_type>& righty,
+    const EllSparseBlockMatDevice<value_type>& leftx,
+    const EllSparseBlockMatDevice<value_type>& lefty,
+    const EllSparseBlockMatDevice<value_type>& jumpX,
+    const EllSparseBlockMatDevice<value_type>& jumpY)
+{
+    const int n = righty.n, Nx = rightx.num_rows, Ny = righty.num_rows;
+    const int Nz = righty.left_size;
+    if( n > 5) //there is no specialized kernel
+        return false;
+    for( auto m : {&rightx, &leftx, &jumpX})
+        if( m->n != n || m->num_rows != Nx || m->num_cols != Nx ||
+            m->right_size != 1 || m->left_size != Nz*Ny*n ||
+            m->right_range[0] != 0 || m->right_range[1] != 1)
+            return false;
+    for( auto m : {&righty, &lefty, &jumpY})
+        if( m->n != n || m->num_rows != Ny || m->num_cols != Ny ||
+            m->right_size != Nx*n || m->left_size != Nz ||
+            m->right_range[0] != 0 || m->right_range[1] != Nx*n)
+            return false;
+    return true;
+}
+
+}//namespace detail
+///@endcond
+}//namespace dg
@@ -24,6 +24,7 @@
 
 #include "accumulate.h"
 #include "ExSUM.FPE.hpp"
+#include "exdot_serial.h"
 #include <omp.h>
 
 namespace dg
@@ -242,6 +243,44 @@ void ExDOTFPE(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c, in
     for ( int i=0; i<maxthreads; i++)
         if( error[i] == true) *err = true;
 }
+// K dot products in one parallel region; every thread sweeps its range in
+// chunks and accumulates all K products per chunk
+template<typename CACHE, typename T1, typename T2>
+void ExDOTFPE_batch(int N, int K, const T1* const* a, const T2* const* b, int64_t* h_superacc, bool* err) {
+    int const linesize = 16;    // * sizeof(int32_t)
+    int maxthreads = omp_get_max_threads();
+    std::vector<std::vector<int64_t>> acc(K, std::vector<int64_t>(maxthreads*BIN_COUNT,0));
+    std::vector<std::vector<int32_t>> ready(K, std::vector<int32_t>(maxthreads * linesize, 0));
+    std::vector<int> error( maxthreads, 0);
+
+    #pragma omp parallel
+    {
+        unsigned int tid = omp_get_thread_num();
+        unsigned int tnum = omp_get_num_threads();
+        //the chunks of all threads but the last start at a multiple of 8
+        int l = ((tid * int64_t(N)) / tnum) & ~7ul;
+        int r = tid+1 == tnum ? N : ((((tid+1) * int64_t(N)) / tnum) & ~7ul);
+        bool local_error = false;
+        for( int i=l; i<r; i+=BATCH_CHUNK_SIZE)
+        {
+            int chunk = std::min( (int)BATCH_CHUNK_SIZE, r-i);
+            for( int k=0; k<K; k++)
+                ExDOTFPE_cpu<CACHE>( chunk, a[k]+i, b[k]+i, &acc[k][tid*BIN_COUNT], &local_error);
+        }
+        if( local_error) error[tid] = 1;
+        for( int k=0; k<K; k++)
+        {
+            int imin=IMIN, imax=IMAX;
+            Normalize(&acc[k][tid*BIN_COUNT], imin, imax);
+            Reduction(tid, tnum, ready[k], acc[k], linesize);
+        }
+    }
+    for( int k=0; k<K; k++)
+        for( int i=IMIN; i<=IMAX; i++)
+            h_superacc[k*BIN_COUNT+i] = acc[k][i];
+    for ( int i=0; i<maxthreads; i++)
+        if( error[i] == 1) *err = true;
+}
 }//namespace cpu
 ///@endcond
 
@@ -279,5 +318,21 @@ void exdot_omp(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, Po
     if( error ) *status = 1;
 }
 
+///@brief OpenMP parallel version of a batch of exact dot products
+///@copydoc hide_exdot_batch
+template<class T1, class T2, size_t NBFPE=8>
+void exdot_batch_omp(unsigned size, unsigned num, const T1* const* x1_ptrs, const T2* const* x2_ptrs, int64_t* h_superacc, int* status){
+    static_assert( has_floating_value<const T1*>::value, "T1 needs to be one of (const) float or (const) double");
+    static_assert( has_floating_value<const T2*>::value, "T2 needs to be one of (const) float or (const) double");
+    bool error = false;
+#ifndef _WITHOUT_VCL
+    cpu::ExDOTFPE_batch<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >((int)size, (int)num, x1_ptrs, x2_ptrs, h_superacc, &error);
+#else
+    cpu::ExDOTFPE_batch<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >((int)size, (int)num, x1_ptrs, x2_ptrs, h_superacc, &error);
+#endif//_WITHOUT_VCL
+    *status = 0;
+    if( error ) *status = 1;
+}
+
 }//namespace exblas
 } //namespace dg
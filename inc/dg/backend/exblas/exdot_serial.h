@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 #include "accumulate.h"
 #include "ExSUM.FPE.hpp"
@@ -45,6 +46,10 @@ union udouble{
 ///@cond
 namespace cpu{
 
+//number of elements per array that a batch of dot products processes at a time
+//(a chunk of 4096 doubles is 32KB, so a few arrays fit into L2 cache)
+static constexpr unsigned BATCH_CHUNK_SIZE = 4096;
+
 template<typename CACHE, typename PointerOrValue1, typename PointerOrValue2>
 void ExDOTFPE_cpu(int N, PointerOrValue1 a, PointerOrValue2 b, int64_t* acc, bool* error) {
     CACHE cache(acc);
@@ -177,6 +182,29 @@ void ExDOTFPE_cpu(int N, PointerOrValue1 a, PointerOrValue2 b, PointerOrValue3 c
  * @param x2_ptr second array
  * @param x3_ptr third array
  */
+/*!@class hide_exdot_batch
+ *
+ * Accumulate the exact sums \f[ \sum_{i=0}^{N-1} x_{k,i} y_{k,i} \f] for
+ * \f$ k=0,\dots,K-1\f$ into \f$ K\f$ superaccumulators in one sweep
+ * through memory.
+ * The arrays are traversed in cache-sized chunks such that every chunk is used
+ * for all \c num products while it is in cache; if the same array appears in
+ * several pairs (e.g. several products with the same vector) it is thus read
+ * from main memory only once. Each superaccumulator is bitwise identical to the
+ * one obtained with the corresponding single dot product.
+ * @ingroup highlevel
+ * @tparam NBFPE size of the floating point expansion (should be between 3 and 8)
+ * @tparam T1 one of (const) float or (const) double
+ * @tparam T2 one of (const) float or (const) double
+ * @param size size N of the arrays to sum
+ * @param num number K of dot products
+ * @param x1_ptrs array of \c num pointers to the first arrays
+ * @param x2_ptrs array of \c num pointers to the second arrays
+ * @param h_superacc pointer to an array of 64 bit integers in **host memory**
+ * with size at least \c num*exblas::BIN_COUNT; the k-th superaccumulator
+ * starts at \c h_superacc+k*exblas::BIN_COUNT (contents are overwritten)
+ * @param status 0 indicates success, 1 indicates an input value was NaN or Inf
+ */
 /*!@class hide_hostacc
  * @param h_superacc pointer to an array of 64 bit integegers (the
  * superaccumulator) in **host memory** with size at least \c exblas::BIN_COUNT
@@ -234,5 +262,28 @@ void exdot_cpu(unsigned size, PointerOrValue1 x1_ptr, PointerOrValue2 x2_ptr, Po
 
 
 
+///@brief Serial version of a batch of exact dot products
+///@copydoc hide_exdot_batch
+template<class T1, class T2, size_t NBFPE=8>
+void exdot_batch_cpu(unsigned size, unsigned num, const T1* const* x1_ptrs, const T2* const* x2_ptrs, int64_t* h_superacc, int* status){
+    static_assert( has_floating_value<const T1*>::value, "T1 needs to be one of (const) float or (const) double");
+    static_assert( has_floating_value<const T2*>::value, "T2 needs to be one of (const) float or (const) double");
+    for( unsigned i=0; i<num*exblas::BIN_COUNT; i++)
+        h_superacc[i] = 0;
+    bool error = false;
+    for( unsigned l=0; l<size; l+=cpu::BATCH_CHUNK_SIZE)
+    {
+        int chunk = std::min( cpu::BATCH_CHUNK_SIZE, size-l);
+        for( unsigned k=0; k<num; k++)
+#ifndef _WITHOUT_VCL
+            cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<vcl::Vec8d, NBFPE, cpu::FPExpansionTraits<true> > >(chunk, x1_ptrs[k]+l, x2_ptrs[k]+l, &h_superacc[k*BIN_COUNT], &error);
+#else
+            cpu::ExDOTFPE_cpu<cpu::FPExpansionVect<double, NBFPE, cpu::FPExpansionTraits<true> > >(chunk, x1_ptrs[k]+l, x2_ptrs[k]+l, &h_superacc[k*BIN_COUNT], &error);
+#endif//_WITHOUT_VCL
+    }
+    *status = 0;
+    if( error ) *status = 1;
+}
+
 }//namespace exblas
 } //namespace dg
@@ -10,18 +10,98 @@
 #include <array>
 #include <vector>
 #include <map>
+#include <utility>
 #include "accumulate.h"
 
 namespace dg
 {
 namespace exblas {
 
+/**
+ * @brief The MPI calls used to reduce superaccumulators among processes
+ *
+ * The scheme is a global runtime setting, see \c exblas::set_mpi_reduction_scheme.
+ * It is unrelated to \c dg::ReductionPolicy, which selects how the local sums are computed
+ * @ingroup highlevel
+ */
+enum class MPIReductionScheme
+{
+    two_step, //!< (default) \c MPI_Reduce within groups of 128 processes, \c MPI_Reduce among the groups and \c MPI_Bcast of the result
+    single_allreduce //!< one \c MPI_Allreduce over the whole communicator with a user defined operation that normalizes the bins
+};
+
 ///@cond
 namespace detail{
 //we keep track of communicators that were created in the past
 static std::map<MPI_Comm, std::array<MPI_Comm, 2>> comm_mods;
+
+inline MPIReductionScheme& mpi_reduction_scheme(){
+    static MPIReductionScheme scheme = MPIReductionScheme::two_step;
+    return scheme;
+}
+
+//inout += in for len superaccumulators; both are normalized first so that
+//the sum of any number of superaccumulators can never overflow
+static void superacc_sum( void* invec, void* inoutvec, int* len, MPI_Datatype*)
+{
+    const int64_t* in = static_cast<const int64_t*>(invec);
+    int64_t* inout = static_cast<int64_t*>(inoutvec);
+    std::array<int64_t, BIN_COUNT> tmp;
+    for( int i=0; i<*len; i++)
+    {
+        for( int k=0; k<BIN_COUNT; k++)
+            tmp[k] = in[i*BIN_COUNT+k];
+        int imin=exblas::IMIN, imax=exblas::IMAX;
+        cpu::Normalize( tmp.data(), imin, imax);
+        imin=exblas::IMIN, imax=exblas::IMAX;
+        cpu::Normalize( &inout[i*BIN_COUNT], imin, imax);
+        for( int k=0; k<BIN_COUNT; k++)
+            inout[i*BIN_COUNT+k] += tmp[k];
+    }
+}
+//the datatype (one superaccumulator) and the operation are created once
+//and live until the end of the program (like the communicators above)
+inline std::pair<MPI_Datatype, MPI_Op> superacc_type_and_op()
+{
+    static MPI_Datatype type = MPI_DATATYPE_NULL;
+    static MPI_Op op = MPI_OP_NULL;
+    if( type == MPI_DATATYPE_NULL)
+    {
+        MPI_Type_contiguous( BIN_COUNT, MPI_INT64_T, &type);
+        MPI_Type_commit( &type);
+        MPI_Op_create( &superacc_sum, 1, &op);
+    }
+    return {type, op};
+}
 }
 ///@endcond
+
+/**
+ * @brief Set the MPI calls used in all subsequent reductions of superaccumulators
+ *
+ * This affects all dot products and averages over MPI vectors. With the
+ * \c single_allreduce scheme every process obtains the reduced
+ * superaccumulators after one collective call instead of three, which
+ * shortens the critical path of every dot product in multi-node runs.
+@code
+dg::exblas::set_mpi_reduction_scheme( dg::exblas::MPIReductionScheme::single_allreduce);
+double norm = dg::blas1::dot( x, x); //one MPI_Allreduce
+@endcode
+ * @param scheme the new scheme
+ * @note The rounded results do not depend on the scheme (the superaccumulators are exact)
+ * @ingroup highlevel
+ */
+inline void set_mpi_reduction_scheme( MPIReductionScheme scheme){
+    detail::mpi_reduction_scheme() = scheme;
+}
+/**
+ * @brief The MPI calls used to reduce superaccumulators
+ * @return the scheme set by \c exblas::set_mpi_reduction_scheme
+ * @ingroup highlevel
+ */
+inline MPIReductionScheme get_mpi_reduction_scheme(){
+    return detail::mpi_reduction_scheme();
+}
 /**
  * @brief This function can be used to partition communicators for the \c exblas::reduce_mpi_cpu function
  *
@@ -62,11 +142,55 @@ static void mpi_reduce_communicator(MPI_Comm comm, MPI_Comm* comm_mod, MPI_Comm*
     }
 }
 
+/*! @brief reduce a number of superaccumulators distributed among mpi processes in a single collective call
+
+The superaccumulators are normalized and summed with one \c MPI_Allreduce
+over \c comm with a user defined operation that normalizes the bins before
+they are added, so any number of processes can participate. As usual the resulting superaccumulator is unnormalized.
+ * @ingroup highlevel
+@param num_superacc number of Superaccumulators eaach process holds
+@param in unnormalized input superaccumulators ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (read/write, undefined on out)
+@param out each process contains the result on output( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (write, may not alias in)
+@param comm The complete MPI communicator
+*/
+static void allreduce_mpi_cpu(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm)
+{
+    for( unsigned i=0; i<num_superacc; i++)
+    {
+        int imin=exblas::IMIN, imax=exblas::IMAX;
+        cpu::Normalize(&in[i*exblas::BIN_COUNT], imin, imax);
+    }
+    auto type_op = detail::superacc_type_and_op();
+    MPI_Allreduce(in, out, num_superacc, type_op.first, type_op.second, comm);
+}
+
+/*! @brief Start a nonblocking version of \c exblas::allreduce_mpi_cpu
+
+The reduction is complete after \c MPI_Wait is called on \c request
+ * @ingroup highlevel
+@param num_superacc number of Superaccumulators eaach process holds
+@param in unnormalized input superaccumulators ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (read/write, undefined on out, must stay alive until the request is complete)
+@param out each process contains the result after the request is complete ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (write, may not alias in)
+@param comm The complete MPI communicator
+@param request (write) handle to be passed to \c MPI_Wait
+*/
+static void iallreduce_mpi_cpu(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm, MPI_Request* request)
+{
+    for( unsigned i=0; i<num_superacc; i++)
+    {
+        int imin=exblas::IMIN, imax=exblas::IMAX;
+        cpu::Normalize(&in[i*exblas::BIN_COUNT], imin, imax);
+    }
+    auto type_op = detail::superacc_type_and_op();
+    MPI_Iallreduce(in, out, num_superacc, type_op.first, type_op.second, comm, request);
+}
+
 /*! @brief reduce a number of superaccumulators distributed among mpi processes
 
 We cannot sum more than 256 accumulators before we need to normalize again, so we need to split the reduction into several steps if more than 256 processes are involved. This function normalizes,
 reduces, normalizes, reduces and broadcasts the result to all participating
 processes.  As usual the resulting superaccumulator is unnormalized.
+If the scheme is \c exblas::MPIReductionScheme::single_allreduce the function calls \c exblas::allreduce_mpi_cpu instead.
  * @ingroup highlevel
 @param num_superacc number of Superaccumulators eaach process holds
 @param in unnormalized input superaccumulators ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (read/write, undefined on out)
@@ -78,6 +202,11 @@ processes.  As usual the resulting superaccumulator is unnormalized.
 */
 static void reduce_mpi_cpu(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm, MPI_Comm comm_mod, MPI_Comm comm_mod_reduce )
 {
+    if( get_mpi_reduction_scheme() == MPIReductionScheme::single_allreduce)
+    {
+        allreduce_mpi_cpu( num_superacc, in, out, comm);
+        return;
+    }
     for( unsigned i=0; i<num_superacc; i++)
     {
         int imin=exblas::IMIN, imax=exblas::IMAX;
@@ -100,5 +229,64 @@ static void reduce_mpi_cpu(  unsigned num_superacc, int64_t* in, int64_t* out, M
     MPI_Bcast( out, num_superacc*exblas::BIN_COUNT, MPI_LONG, 0, comm);
 }
 
+/*! @brief Start a nonblocking reduction of superaccumulators distributed among mpi processes
+
+The superaccumulators are normalized and summed with \c MPI_Iallreduce within \c comm_mod.
+This is the only step if \c comm has no more than 128 processes; otherwise the partial sums
+of each \c comm_mod group are combined in \c exblas::ireduce_mpi_cpu_wait.
+Between the two calls the caller is free to do work that does not touch \c in or \c out.
+ * @ingroup highlevel
+@param num_superacc number of Superaccumulators eaach process holds
+@param in unnormalized input superaccumulators ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (read/write, undefined on out, must stay alive until \c exblas::ireduce_mpi_cpu_wait returns)
+@param out each process contains the result after \c exblas::ireduce_mpi_cpu_wait ( must be of size num_superacc*\c exblas::BIN_COUNT, allocated on the cpu) (write, may not alias in)
+@param comm_mod This is comm modulo 128 ( or any other number <256)
+@param request (write) handle to be passed to \c exblas::ireduce_mpi_cpu_wait
+@sa \c exblas::mpi_reduce_communicator to generate the required communicators
+*/
+static void ireduce_mpi_cpu(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm_mod, MPI_Request* request )
+{
+    for( unsigned i=0; i<num_superacc; i++)
+    {
+        int imin=exblas::IMIN, imax=exblas::IMAX;
+        cpu::Normalize(&in[i*exblas::BIN_COUNT], imin, imax);
+    }
+    MPI_Iallreduce(in, out, num_superacc*exblas::BIN_COUNT, MPI_LONG, MPI_SUM, comm_mod, request);
+}
+
+/*! @brief Complete a reduction started with \c exblas::ireduce_mpi_cpu
+
+Waits for the reduction within \c comm_mod and, if \c comm consists of more than one \c comm_mod group,
+normalizes, reduces among the groups and broadcasts the result. As usual the resulting superaccumulator is unnormalized.
+ * @ingroup highlevel
+@param num_superacc number of Superaccumulators eaach process holds
+@param in same as in \c exblas::ireduce_mpi_cpu (undefined on out)
+@param out each process contains the result on output
+@param comm The complete MPI communicator
+@param comm_mod This is comm modulo 128 ( or any other number <256)
+@param comm_mod_reduce This is the communicator consisting of all rank 0 processes in comm_mod, may be \c MPI_COMM_NULL
+@param request the handle returned by \c exblas::ireduce_mpi_cpu
+*/
+static void ireduce_mpi_cpu_wait(  unsigned num_superacc, int64_t* in, int64_t* out, MPI_Comm comm, MPI_Comm comm_mod, MPI_Comm comm_mod_reduce, MPI_Request* request )
+{
+    MPI_Wait( request, MPI_STATUS_IGNORE);
+    int size, size_mod;
+    MPI_Comm_size( comm, &size);
+    MPI_Comm_size( comm_mod, &size_mod);
+    if( size == size_mod)
+        return;
+    if(comm_mod_reduce != MPI_COMM_NULL)
+    {
+        for( unsigned i=0; i<num_superacc; i++)
+        {
+            int imin=exblas::IMIN, imax=exblas::IMAX;
+            cpu::Normalize(&out[i*exblas::BIN_COUNT], imin, imax);
+            for( int k=0; k<exblas::BIN_COUNT; k++)
+                in[i*BIN_COUNT+k] = out[i*BIN_COUNT+k];
+        }
+        MPI_Allreduce(in, out, num_superacc*exblas::BIN_COUNT, MPI_LONG, MPI_SUM, comm_mod_reduce);
+    }
+    MPI_Bcast( out, num_superacc*exblas::BIN_COUNT, MPI_LONG, 0, comm_mod);
+}
+
 }//namespace exblas
 } //namespace dg
@@ -25,5 +25,52 @@ struct SerialTag    : public AnyPolicyTag{};
 struct CudaTag      : public AnyPolicyTag{};//!< CUDA implementation
 struct OmpTag       : public AnyPolicyTag{};//!< OpenMP parallel execution
 
+/**
+ * @brief Summation algorithm of the scalar products \c dg::blas1::dot and \c dg::blas2::dot
+ *
+ * The policy is a global runtime setting, see \c dg::set_reduction_policy
+ * @ingroup dispatch
+ */
+enum class ReductionPolicy
+{
+    reproducible, //!< (default) exact summation with the exblas superaccumulators; results are binary reproducible independent of the number of threads and processes
+    fast //!< compensated summation in independent SIMD lanes per thread; results are accurate to a few ulps but depend on the number of threads (the partial sums of threads and processes are still summed exactly). Only used by the serial and OpenMP backends, CUDA always uses the reproducible summation
+};
+
+///@cond
+namespace detail
+{
+inline ReductionPolicy& reduction_policy(){
+    static ReductionPolicy policy = ReductionPolicy::reproducible;
+    return policy;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Set the summation algorithm of all subsequent scalar products
+ *
+ * Use \c dg::ReductionPolicy::fast for production runs where the (small) speed
+ * advantage matters more than binary reproducibility
+@code
+dg::set_reduction_policy( dg::ReductionPolicy::fast);
+double norm = dg::blas1::dot( x, x); //compensated summation
+dg::set_reduction_policy( dg::ReductionPolicy::reproducible);
+@endcode
+ * @param policy the new policy
+ * @ingroup dispatch
+ */
+inline void set_reduction_policy( ReductionPolicy policy){
+    detail::reduction_policy() = policy;
+}
+/**
+ * @brief The current summation algorithm of scalar products
+ * @return the policy set by \c dg::set_reduction_policy
+ * @ingroup dispatch
+ */
+inline ReductionPolicy get_reduction_policy(){
+    return detail::reduction_policy();
+}
+
 
 }//namespace dg
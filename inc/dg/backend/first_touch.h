@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <thrust/device_vector.h>
+#include <thrust/device_malloc_allocator.h>
+#include "config.h"
+
+namespace dg
+{
+
+/**
+ * @brief NUMA-aware allocator for \c thrust::device_vector in the OpenMP backend
+ *
+ * On multi-socket nodes the operating system places a memory page on the
+ * socket of the thread that first writes to it ("first touch"). Vectors
+ * that are initialized in a serial loop therefore end up entirely on the
+ * memory of one socket and all OpenMP kernels have to stream through the
+ * interconnect. This allocator writes newly allocated memory in parallel with
+ * the static schedule of the OpenMP elementwise (\c dg::blas1) and
+ * sparse block matrix (\c dg::blas2) kernels such that every thread later
+ * works on pages that are local to its socket.
+ * The allocator is a drop-in replacement for the default allocator: use it
+ * through the \c dg::NumaDVec typedefs (or \c dg::x::NumaDVec)
+@code
+dg::x::NumaDVec x = dg::construct<dg::x::NumaDVec>( dg::evaluate( dg::one, grid));
+@endcode
+ * @note With the CUDA backend or without OpenMP the allocator is equivalent
+ * to the default allocator
+ * @attention Threads should be pinned to cores (e.g. \c OMP_PROC_BIND=true)
+ * and the number of threads should not change during the program, otherwise
+ * the placement of pages does not match the work distribution
+ * @tparam T value type
+ * @ingroup typedefs
+ */
+template<class T>
+struct FirstTouchAllocator : public thrust::device_malloc_allocator<T>
+{
+    using super_t   = thrust::device_malloc_allocator<T>;
+    using pointer   = typename super_t::pointer;
+    using size_type = typename super_t::size_type;
+    template<class U>
+    struct rebind
+    {
+        using other = FirstTouchAllocator<U>; //!< allocator for U
+    };
+    FirstTouchAllocator() = default;
+    FirstTouchAllocator( const FirstTouchAllocator&) = default;
+    template<class U>
+    FirstTouchAllocator( const FirstTouchAllocator<U>&){}
+    ///@brief allocate and touch memory for \c n elements
+    pointer allocate( size_type n)
+    {
+        pointer p = super_t::allocate( n);
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_OMP && defined(_OPENMP)
+        char* raw = reinterpret_cast<char*>( thrust::raw_pointer_cast( p));
+        //a signed index that does not narrow n (vectors may exceed INT_MAX)
+        const std::ptrdiff_t size = n;
+        #pragma omp parallel for schedule(static)
+        for( std::ptrdiff_t i=0; i<size; i++)
+            std::memset( raw + i*sizeof(T), 0, sizeof(T));
+#endif //THRUST_DEVICE_SYSTEM
+        return p;
+    }
+};
+
+///@cond
+template<class T, class U>
+bool operator==( const FirstTouchAllocator<T>&, const FirstTouchAllocator<U>&){ return true;}
+template<class T, class U>
+bool operator!=( const FirstTouchAllocator<T>&, const FirstTouchAllocator<U>&){ return false;}
+///@endcond
+
+}//namespace dg
@@ -1,6 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <utility>
+#include <initializer_list>
+#include <array>
+#include <tuple>
+#include "tensor_traits.h"
+#include "tensor_traits_scalar.h"
+#include "tensor_traits_std.h"
 
 namespace dg
 {
@@ -187,4 +195,276 @@ struct Buffer
     T* ptr;
 };
 
+///@cond
+namespace detail
+{
+//The size (and communicator) of a container without its data, such that
+//new containers of the same shape can be made at any time.
+//Containers that cannot be described by their size are copied.
+template<class ContainerType, class Category = get_tensor_category<ContainerType>>
+struct ContainerShape
+{
+    ContainerShape() = default;
+    ContainerShape( const ContainerType& src): m_copy( src){}
+    ContainerType make() const{ return m_copy;}
+    private:
+    ContainerType m_copy;
+};
+template<class ContainerType>
+struct ContainerShape<ContainerType, ThrustVectorTag>
+{
+    ContainerShape() = default;
+    ContainerShape( const ContainerType& src): m_size( src.size()){}
+    ContainerType make() const{ return ContainerType( m_size);}
+    private:
+    std::size_t m_size = 0;
+};
+template<class ContainerType>
+struct ContainerShape<ContainerType, MPIVectorTag>
+{
+    ContainerShape() = default;
+    ContainerShape( const ContainerType& src): m_data( src.data()),
+        m_comm( src.communicator()), m_comm128( src.communicator_mod()),
+        m_comm128Reduce( src.communicator_mod_reduce()){}
+    ContainerType make() const{
+        //set_communicator avoids the collective call of the constructor
+        ContainerType out;
+        out.data() = m_data.make();
+        out.set_communicator( m_comm, m_comm128, m_comm128Reduce);
+        return out;
+    }
+    private:
+    using comm_type = decltype( std::declval<ContainerType>().communicator()); //MPI_Comm
+    ContainerShape<typename ContainerType::container_type> m_data;
+    comm_type m_comm, m_comm128, m_comm128Reduce;
+};
+template<class ContainerType>
+struct ContainerShape<ContainerType, RecursiveVectorTag>
+{
+    ContainerShape() = default;
+    ContainerShape( const ContainerType& src){
+        for( unsigned i=0; i<src.size(); i++)
+            m_elements.push_back( src[i]);
+    }
+    ContainerType make() const{
+        ContainerType out;
+        out.reserve( m_elements.size());
+        for( unsigned i=0; i<m_elements.size(); i++)
+            out.push_back( m_elements[i].make());
+        return out;
+    }
+    private:
+    std::vector<ContainerShape<typename ContainerType::value_type>> m_elements;
+};
+template<class ContainerType>
+struct ContainerShape<ContainerType, ArrayVectorTag>
+{
+    ContainerShape() = default;
+    ContainerShape( const ContainerType& src){
+        for( unsigned i=0; i<src.size(); i++)
+            m_elements[i] = src[i];
+    }
+    ContainerType make() const{
+        ContainerType out;
+        for( unsigned i=0; i<out.size(); i++)
+            out[i] = m_elements[i].make();
+        return out;
+    }
+    private:
+    std::array<ContainerShape<typename ContainerType::value_type>, std::tuple_size<ContainerType>::value> m_elements;
+};
+}//namespace detail
+///@endcond
+
+/**
+* @brief A pool of temporary containers that can be shared between objects
+*
+* Many classes (solvers, timesteppers, physics models) need full-size
+* temporaries only while one of their member functions executes.
+* If these classes each own their private copies, memory is wasted for
+* objects that never run at the same time, e.g. the solvers of a
+* timestepper. A Workspace owns a pool of containers of the size of a
+* "copyable" container and lends them out with scoped lifetimes: a
+* borrowed container returns to the pool when the corresponding
+* \c Temporary handle is destroyed and can then be borrowed by the next
+* object. Containers are only allocated if the pool is empty, so after the
+* first call the number of allocated containers is the maximum number of
+* temporaries simultaneously in use. The workspace itself only stores the
+* size (and for MPI vectors the communicator) of the containers, not a
+* full-size prototype.
+@code
+auto ws = std::make_shared<dg::Workspace<dg::DVec>>( copyable);
+dg::CG<dg::DVec> pcg( copyable, 1000);
+pcg.set_workspace( ws);
+dg::LGMRES<dg::DVec> lgmres( copyable, 3, 30, 100);
+lgmres.set_workspace( ws); // shares memory with pcg
+{
+    auto tmp = ws->borrow();
+    dg::blas1::axpby( 1., x, 1., y, *tmp);
+} // tmp is returned to the pool here
+@endcode
+* There are two ways to borrow: \c borrow() returns a handle to a container
+* of the pool and \c borrow(ContainerType&) moves the memory of a pooled
+* container into an existing (empty) container, typically a class member,
+* and moves it back when the handle is destroyed. The latter is how the
+* library classes use a workspace without changes to their algorithms.
+* @note The values of a borrowed container are undefined
+* @attention A Workspace must outlive all handles borrowed from it and is not thread-safe.
+* Objects sharing a workspace must not use it concurrently (e.g. from
+* different OpenMP threads) and a borrowed container must not be used after
+* its handle is destroyed
+* @tparam ContainerType must be copy-constructible, default-constructible and swappable
+* @ingroup lowlevel
+*/
+template<class ContainerType>
+struct Workspace
+{
+    /**
+    * @brief A scoped handle to a borrowed container
+    *
+    * Move-only, returns the container to its workspace on destruction.
+    * A default constructed handle is empty and does nothing.
+    */
+    struct Temporary
+    {
+        ///empty handle
+        Temporary() = default;
+        Temporary( const Temporary&) = delete;
+        Temporary& operator=( const Temporary&) = delete;
+        ///steal the borrowed container of \c src
+        Temporary( Temporary&& src) noexcept{
+            swap( *this, src);
+        }
+        ///return the currently borrowed container and steal the one of \c src
+        Temporary& operator=( Temporary&& src) noexcept{
+            Temporary tmp( std::move(src));
+            swap( *this, tmp);
+            return *this;
+        }
+        ///Give the container back to the workspace
+        ~Temporary(){
+            if( m_ws)
+                m_ws->give_back( std::move( m_storage), m_target);
+        }
+        ///swap two handles
+        friend void swap( Temporary& first, Temporary& second) noexcept
+        {
+            std::swap( first.m_ws, second.m_ws);
+            std::swap( first.m_storage, second.m_storage);
+            std::swap( first.m_target, second.m_target);
+        }
+        ///@return the borrowed container (the target if the handle was constructed with \c Workspace::borrow(ContainerType&))
+        ContainerType& operator*() const { return m_target ? *m_target : *m_storage;}
+        ///@return pointer to the borrowed container
+        ContainerType* operator->() const { return &(**this);}
+        ///\c true if the handle holds a borrowed container
+        explicit operator bool() const{ return m_ws != nullptr;}
+        private:
+        friend struct Workspace;
+        Temporary( Workspace* ws, std::unique_ptr<ContainerType> storage, ContainerType* target): m_ws(ws), m_storage(std::move(storage)), m_target(target){
+            if( m_target)
+            {
+                using std::swap;
+                swap( *m_storage, *m_target);
+            }
+        }
+        Workspace* m_ws = nullptr;
+        std::unique_ptr<ContainerType> m_storage;
+        ContainerType* m_target = nullptr;
+    };
+
+    ///@brief Allocate nothing, call \c set_copyable before usage
+    Workspace(){}
+    ///@copydoc set_copyable()
+    Workspace( const ContainerType& copyable): m_shape(copyable){}
+    /**
+    * @brief Set the size of the containers in the pool
+    *
+    * Frees all pooled containers
+    * @param copyable all containers in the pool have the size of this (only its size
+    * and communicator are stored, not its data)
+    * @attention Must not be called while containers are borrowed
+    */
+    void set_copyable( const ContainerType& copyable){
+        m_shape = detail::ContainerShape<ContainerType>( copyable);
+        shrink_to_fit();
+    }
+    ///@brief Make a new object of same size as the containers in the pool
+    ///@return A copyable object (allocated by this call); what it contains is undefined, its size is important
+    ContainerType copyable() const{ return m_shape.make();}
+
+    /**
+    * @brief Borrow a container from the pool
+    *
+    * @return a handle to a container of the size of \c copyable(), allocated only if the pool is empty
+    */
+    Temporary borrow(){
+        return Temporary( this, take(), nullptr);
+    }
+    /**
+    * @brief Lend the memory of a pooled container to \c target
+    *
+    * The contents of \c target and a pooled container are swapped. When the
+    * returned handle is destroyed they are swapped back, i.e. \c target
+    * regains its previous (usually empty) state.
+    * @param target typically an empty member variable of a class
+    * @return a handle that must live as long as \c target is used
+    */
+    Temporary borrow( ContainerType& target){
+        return Temporary( this, take(), &target);
+    }
+    /**
+    * @brief Lend the memory of pooled containers to several targets
+    *
+    * @param targets pointers to the containers that borrow memory
+    * @return one handle for each target
+    */
+    std::vector<Temporary> borrow( std::initializer_list<ContainerType*> targets){
+        std::vector<Temporary> handles;
+        handles.reserve( targets.size());
+        for( auto target : targets)
+            handles.push_back( borrow( *target));
+        return handles;
+    }
+    ///@copydoc borrow(std::initializer_list<ContainerType*>)
+    std::vector<Temporary> borrow( std::vector<ContainerType>& targets){
+        std::vector<Temporary> handles;
+        handles.reserve( targets.size());
+        for( auto& target : targets)
+            handles.push_back( borrow( target));
+        return handles;
+    }
+    ///@return the number of containers currently owned by the pool and the borrowers
+    unsigned num_allocated() const { return m_allocated;}
+    ///@return the number of containers currently borrowed
+    unsigned num_borrowed() const { return m_allocated - m_pool.size();}
+    ///@brief Free the containers that are currently not borrowed
+    void shrink_to_fit(){
+        m_allocated -= m_pool.size();
+        m_pool.clear();
+    }
+    private:
+    std::unique_ptr<ContainerType> take(){
+        if( m_pool.empty())
+        {
+            m_allocated++;
+            return std::unique_ptr<ContainerType>( new ContainerType( m_shape.make()));
+        }
+        std::unique_ptr<ContainerType> storage = std::move( m_pool.back());
+        m_pool.pop_back();
+        return storage;
+    }
+    void give_back( std::unique_ptr<ContainerType> storage, ContainerType* target){
+        if( target)
+        {
+            using std::swap;
+            swap( *storage, *target);
+        }
+        m_pool.push_back( std::move( storage));
+    }
+    detail::ContainerShape<ContainerType> m_shape;
+    std::vector<std::unique_ptr<ContainerType>> m_pool;
+    unsigned m_allocated = 0;
+};
+
 }//namespace dg
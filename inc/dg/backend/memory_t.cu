@@ -1,4 +1,5 @@
 #include <iostream>
+#include <vector>
 
 #include "memory.h"
 
@@ -63,6 +64,30 @@ int main()
         buffer2.data().speak();
         std::swap( buffer, buffer2);
     }
+    {
+        std::cout << "Test correct behaviour of workspace class\n";
+        dg::Workspace<std::vector<double>> ws( std::vector<double>( 10, 0.));
+        std::vector<double> member;
+        {
+            auto tmp = ws.borrow();
+            auto borrowed = ws.borrow( member);
+            std::cout << "Borrowed "<<ws.num_borrowed()<<" (2) of size "<<tmp->size()<<" and "<<member.size()<<" (10 10)\n";
+            auto moved = std::move( tmp);
+            std::cout << "Moved handle is "<<(bool)tmp<<" (0) and "<<(bool)moved<<" (1)\n";
+        }
+        std::cout << "Returned all "<<ws.num_borrowed()<<" (0) size of member "<<member.size()<<" (0)\n";
+        {
+            std::vector<std::vector<double>> members( 3);
+            auto borrowed = ws.borrow( members);
+            std::cout << "Allocated "<<ws.num_allocated()<<" (3) size "<<members[2].size()<<" (10)\n";
+        }
+        ws.shrink_to_fit();
+        std::cout << "After shrink allocated "<<ws.num_allocated()<<" (0)\n";
+        ws.borrow();
+        ws.set_copyable( std::vector<double>( 5, 0.));
+        std::cout << "After set_copyable allocated "<<ws.num_allocated()<<" (0)";
+        std::cout << " size "<<ws.borrow()->size()<<" (5)\n";
+    }
 
     return 0;
 }
@@ -15,6 +15,58 @@
 
 namespace dg{
 
+/**
+ * @brief The MPI calls used in the global gather and scatter of
+ * \c dg::BijectiveComm, \c dg::SurjectiveComm and \c dg::GeneralComm
+ *
+ * The policy is a global runtime setting, see \c dg::set_collective_policy
+ * @ingroup mpi_structures
+ */
+enum class CollectivePolicy
+{
+    alltoallv, //!< (default) one \c MPI_Alltoallv over the whole communicator
+    point_to_point //!< \c MPI_Isend and \c MPI_Irecv pairs only with the processes that actually exchange data
+};
+
+///@cond
+namespace detail
+{
+inline CollectivePolicy& collective_policy(){
+    static CollectivePolicy policy = CollectivePolicy::alltoallv;
+    return policy;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Set the MPI calls used in all subsequent global gather and scatter operations
+ *
+ * The cost of \c MPI_Alltoallv grows with the number of processes in the
+ * communicator even if each process only exchanges data with a few other
+ * processes (as is the case e.g. for the interpolation in
+ * \c dg::geo::Fieldaligned). With the \c point_to_point policy every process
+ * only communicates with the partners that were found when the
+ * communicator was constructed.
+@code
+dg::set_collective_policy( dg::CollectivePolicy::point_to_point);
+dg::blas2::symv( interpolation, x, y); //only neighbors communicate
+@endcode
+ * @param policy the new policy
+ * @note The results do not depend on the policy
+ * @ingroup mpi_structures
+ */
+inline void set_collective_policy( CollectivePolicy policy){
+    detail::collective_policy() = policy;
+}
+/**
+ * @brief The MPI calls used in global gather and scatter operations
+ * @return the policy set by \c dg::set_collective_policy
+ * @ingroup mpi_structures
+ */
+inline CollectivePolicy get_collective_policy(){
+    return detail::collective_policy();
+}
+
 ///@cond
 
 /**
@@ -44,22 +96,48 @@ struct Collective
 
     void construct( thrust::host_vector<int> sendTo, MPI_Comm comm){
         //sollte schnell sein
-        thrust::host_vector<int> recvFrom(sendTo), accS(sendTo), accR(sendTo);
+        thrust::host_vector<int> recvFrom(sendTo.size(), 0), accS(sendTo), accR(sendTo);
         m_comm=comm;
-        int rank, size;
-        MPI_Comm_rank( m_comm, &rank);
+        int size;
         MPI_Comm_size( m_comm, &size);
         assert( sendTo.size() == (unsigned)size);
-        thrust::host_vector<unsigned> global( size*size);
-        MPI_Allgather( sendTo.data(), size, MPI_UNSIGNED,
-                       global.data(), size, MPI_UNSIGNED,
-                       m_comm);
-        for( unsigned i=0; i<(unsigned)size; i++)
-            recvFrom[i] = global[i*size+rank];
+        //Every process only learns from how many processes it receives
+        //(instead of gathering the whole size x size matrix on all processes)
+        std::vector<int> sends( size, 0);
+        for( int i=0; i<size; i++)
+            sends[i] = sendTo[i] != 0 ? 1 : 0;
+        int num_senders = 0;
+        MPI_Reduce_scatter_block( sends.data(), &num_senders, 1, MPI_INT,
+                MPI_SUM, m_comm);
+        //and then receives the actual numbers directly from the senders
+        std::vector<int> counts( num_senders);
+        std::vector<MPI_Request> rqst;
+        for( int k=0; k<num_senders; k++)
+        {
+            rqst.push_back( MPI_REQUEST_NULL);
+            MPI_Irecv( &counts[k], 1, MPI_INT, MPI_ANY_SOURCE, 7, m_comm,
+                    &rqst.back());
+        }
+        for( int i=0; i<size; i++)
+            if( sendTo[i] != 0)
+            {
+                rqst.push_back( MPI_REQUEST_NULL);
+                MPI_Isend( &sendTo[i], 1, MPI_INT, i, 7, m_comm, &rqst.back());
+            }
+        std::vector<MPI_Status> status( rqst.size());
+        MPI_Waitall( rqst.size(), rqst.data(), status.data());
+        for( int k=0; k<num_senders; k++)
+            recvFrom[status[k].MPI_SOURCE] = counts[k];
         thrust::exclusive_scan( sendTo.begin(),   sendTo.end(),   accS.begin());
         thrust::exclusive_scan( recvFrom.begin(), recvFrom.end(), accR.begin());
         m_sendTo=sendTo, m_recvFrom=recvFrom, m_accS=accS, m_accR=accR;
-    
+        //the partners for the point to point exchange
+        m_sendPids.clear(), m_recvPids.clear();
+        for( int i=0; i<size; i++)
+        {
+            if( m_sendTo[i] != 0) m_sendPids.push_back(i);
+            if( m_recvFrom[i] != 0) m_recvPids.push_back(i);
+        }
     }
     /**
      * @brief Number of processes in the communicator
@@ -71,8 +149,12 @@ struct Collective
     unsigned size() const {return values_size();}
     MPI_Comm comm() const {return m_comm;}
 
-    void transpose(){ m_sendTo.swap( m_recvFrom);}
-    void invert(){ m_sendTo.swap( m_recvFrom);}
+    void transpose(){
+        m_sendTo.swap( m_recvFrom);
+        m_accS.swap( m_accR);
+        m_sendPids.swap( m_recvPids);
+    }
+    void invert(){ transpose();}
 
     void scatter( const Vector& values, Vector& store) const;
     void gather( const Vector& store, Vector& values) const;
@@ -90,6 +172,12 @@ struct Collective
     private:
     unsigned sendTo( unsigned pid) const {return m_sendTo[pid];}
     unsigned recvFrom( unsigned pid) const {return m_recvFrom[pid];}
+    //send send[accS[pid]...] to all pid in sendPids and receive into recv[accR[pid]...] from all pid in recvPids
+    template<class value_type>
+    void alltoallv( const value_type* send, const thrust::host_vector<int>& sendTo, const thrust::host_vector<int>& accS, const std::vector<int>& sendPids,
+        value_type* recv, const thrust::host_vector<int>& recvFrom, const thrust::host_vector<int>& accR, const std::vector<int>& recvPids) const;
+    std::vector<int> m_sendPids, m_recvPids; //partners with non-zero message
+    mutable std::vector<MPI_Request> m_rqst;
 #ifdef _DG_CUDA_UNAWARE_MPI
     thrust::host_vector<int> m_sendTo,   m_accS;
     thrust::host_vector<int> m_recvFrom, m_accR;
@@ -103,6 +191,34 @@ struct Collective
     MPI_Comm m_comm;
 };
 
+template< class Index, class Device>
+template< class value_type>
+void Collective<Index, Device>::alltoallv(
+        const value_type* send, const thrust::host_vector<int>& sendTo, const thrust::host_vector<int>& accS, const std::vector<int>& sendPids,
+        value_type* recv, const thrust::host_vector<int>& recvFrom, const thrust::host_vector<int>& accR, const std::vector<int>& recvPids) const
+{
+    if( get_collective_policy() == CollectivePolicy::alltoallv)
+    {
+        MPI_Alltoallv(
+            send, thrust::raw_pointer_cast( sendTo.data()),
+            thrust::raw_pointer_cast( accS.data()), getMPIDataType<value_type>(),
+            recv, thrust::raw_pointer_cast( recvFrom.data()),
+            thrust::raw_pointer_cast( accR.data()), getMPIDataType<value_type>(), m_comm);
+        return;
+    }
+    //the tag differs from the ones of dg::NearestNeighborComm (3 and 9), such
+    //that halo messages in flight on the same communicator cannot be matched
+    const int tag = 13;
+    m_rqst.resize( sendPids.size() + recvPids.size());
+    for( unsigned i=0; i<recvPids.size(); i++)
+        MPI_Irecv( recv + accR[recvPids[i]], recvFrom[recvPids[i]],
+                getMPIDataType<value_type>(), recvPids[i], tag, m_comm, &m_rqst[i]);
+    for( unsigned i=0; i<sendPids.size(); i++)
+        MPI_Isend( send + accS[sendPids[i]], sendTo[sendPids[i]],
+                getMPIDataType<value_type>(), sendPids[i], tag, m_comm, &m_rqst[recvPids.size()+i]);
+    MPI_Waitall( m_rqst.size(), m_rqst.data(), MPI_STATUSES_IGNORE);
+}
+
 template< class Index, class Device>
 void Collective<Index, Device>::scatter( const Device& values, Device& store) const
 {
@@ -114,22 +230,12 @@ void Collective<Index, Device>::scatter( const Device& values, Device& store) co
 #ifdef _DG_CUDA_UNAWARE_MPI
     m_values.data() = values;
     m_store.data().resize( store.size());
-    MPI_Alltoallv(
-            thrust::raw_pointer_cast( m_values.data().data()),
-            thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(),
-            thrust::raw_pointer_cast( m_store.data().data()),
-            thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+    alltoallv( thrust::raw_pointer_cast( m_values.data().data()), m_sendTo, m_accS, m_sendPids,
+            thrust::raw_pointer_cast( m_store.data().data()), m_recvFrom, m_accR, m_recvPids);
     store = m_store.data();
 #else
-    MPI_Alltoallv(
-            thrust::raw_pointer_cast( values.data()),
-            thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(),
-            thrust::raw_pointer_cast( store.data()),
-            thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+    alltoallv( thrust::raw_pointer_cast( values.data()), m_sendTo, m_accS, m_sendPids,
+            thrust::raw_pointer_cast( store.data()), m_recvFrom, m_accR, m_recvPids);
 #endif //_DG_CUDA_UNAWARE_MPI
 }
 
@@ -145,22 +251,12 @@ void Collective<Index, Device>::gather( const Device& gatherFrom, Device& values
 #ifdef _DG_CUDA_UNAWARE_MPI
     m_store.data() = gatherFrom;
     m_values.data().resize( values.size());
-    MPI_Alltoallv(
-            thrust::raw_pointer_cast( m_store.data().data()),
-            thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(),
-            thrust::raw_pointer_cast( m_values.data().data()),
-            thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+    alltoallv( thrust::raw_pointer_cast( m_store.data().data()), m_recvFrom, m_accR, m_recvPids,
+            thrust::raw_pointer_cast( m_values.data().data()), m_sendTo, m_accS, m_sendPids);
     values = m_values.data();
 #else
-    MPI_Alltoallv(
-            thrust::raw_pointer_cast( gatherFrom.data()),
-            thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(),
-            thrust::raw_pointer_cast( values.data()),
-            thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+    alltoallv( thrust::raw_pointer_cast( gatherFrom.data()), m_recvFrom, m_accR, m_recvPids,
+            thrust::raw_pointer_cast( values.data()), m_sendTo, m_accS, m_sendPids);
 #endif //_DG_CUDA_UNAWARE_MPI
 }
 //BijectiveComm ist der Spezialfall, dass jedes Element nur ein einziges Mal gebraucht wird.
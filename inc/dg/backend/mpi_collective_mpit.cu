@@ -73,6 +73,19 @@ int main( int argc, char * argv[])
             std::cerr <<"Rank "<<rank<<" FAILED "<<std::endl;
     }
     if(fabs(norm1-norm2)>1e-14 && rank==0)std::cout << norm1 << " "<<norm2<< " "<<norm1-norm2<<std::endl;
+    MPI_Barrier(MPI_COMM_WORLD);
+    if(rank==0)std::cout << "Test GeneralComm with point to point communication gives same result as Alltoallv: "<<std::endl;
+    dg::set_collective_policy( dg::CollectivePolicy::point_to_point);
+    thrust::host_vector<double> receive_p2p = s.global_gather( thrust::raw_pointer_cast(vec.data()));
+    thrust::host_vector<double> vec3(vec.size(), 7e6);
+    s.global_scatter_reduce( receive_p2p, thrust::raw_pointer_cast(vec3.data()));
+    dg::set_collective_policy( dg::CollectivePolicy::alltoallv);
+    {
+        if( receive_p2p == receive && vec3 == vec2)
+            std::cout <<"Rank "<<rank<<" PASSED "<<std::endl;
+        else
+            std::cerr <<"Rank "<<rank<<" FAILED "<<std::endl;
+    }
 
     MPI_Finalize();
 
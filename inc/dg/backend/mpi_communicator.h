@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <mpi.h>
 
 namespace dg
@@ -17,6 +18,123 @@ template<>
 inline MPI_Datatype getMPIDataType<unsigned>(){ return MPI_UNSIGNED;}
 ///@endcond
 
+/**
+ * @brief The MPI calls used in the halo exchange of \c dg::NearestNeighborComm
+ *
+ * The policy is a global runtime setting, see \c dg::set_halo_exchange_policy
+ * @ingroup mpi_structures
+ */
+enum class HaloExchangePolicy
+{
+    isend_irecv, //!< (default) post new \c MPI_Isend and \c MPI_Irecv pairs in every exchange
+    persistent, //!< create persistent requests with \c MPI_Send_init and \c MPI_Recv_init once per communicator and buffer and reuse them with \c MPI_Startall
+    neighbor_alltoallw, //!< a single \c MPI_Ineighbor_alltoallw over the Cartesian communicator (falls back to \c isend_irecv for MPI versions below 3 and if both neighbors are the same process)
+    shared_window //!< neighbors on the same node read the halo directly from an MPI-3 shared memory window and only synchronize with empty messages, neighbors on other nodes use \c MPI_Isend and \c MPI_Irecv. The window is created (collectively) when a \c dg::NearestNeighborComm is constructed while this policy is set and shared with its copies; communicators constructed under another policy use \c isend_irecv (also for MPI versions below 3 and for CUDA vectors)
+};
+
+///@cond
+namespace detail
+{
+inline HaloExchangePolicy& halo_exchange_policy(){
+    static HaloExchangePolicy policy = HaloExchangePolicy::isend_irecv;
+    return policy;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Set the MPI calls used in all subsequent halo exchanges
+ *
+ * Halo exchanges happen several times in each application of e.g. an
+ * \c dg::Elliptic operator. In strong scaling runs, where messages are small,
+ * the setup cost of each message can be reduced by persistent requests or
+ * a neighborhood collective. With several processes per node the
+ * shared memory windows avoid the message copies between processes on the
+ * same node. Which one is faster depends on the MPI library
+ * and the network.
+@code
+dg::set_halo_exchange_policy( dg::HaloExchangePolicy::persistent);
+dg::blas2::symv( dx, x, y); //uses persistent requests
+@endcode
+ * @param policy the new policy
+ * @note The results do not depend on the policy
+ * @ingroup mpi_structures
+ */
+inline void set_halo_exchange_policy( HaloExchangePolicy policy){
+    detail::halo_exchange_policy() = policy;
+}
+/**
+ * @brief The MPI calls used in halo exchanges
+ * @return the policy set by \c dg::set_halo_exchange_policy
+ * @ingroup mpi_structures
+ */
+inline HaloExchangePolicy get_halo_exchange_policy(){
+    return detail::halo_exchange_policy();
+}
+
+/**
+ * @brief How \c dg::NearestNeighborComm sends halo layers that are not contiguous in memory
+ *
+ * The policy is a global runtime setting for each direction, see \c dg::set_halo_packing_policy
+ * @ingroup mpi_structures
+ */
+enum class HaloPackingPolicy
+{
+    pack, //!< (default) gather the layers into a contiguous buffer and send the buffer
+    derived_datatype //!< describe the layers with \c MPI_Type_vector and send directly from the input vector; the layers are packed for the local computation while the messages are in flight (only with the \c isend_irecv and \c persistent halo exchange policies and not for CUDA vectors, falls back to \c pack otherwise)
+};
+
+///@cond
+namespace detail
+{
+inline std::array<HaloPackingPolicy,3>& halo_packing_policy(){
+    static std::array<HaloPackingPolicy,3> policy = {HaloPackingPolicy::pack,
+        HaloPackingPolicy::pack, HaloPackingPolicy::pack};
+    return policy;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Set how halo layers are sent in all subsequent halo exchanges in the given direction
+ *
+ * In the x-direction (and the y-direction of three-dimensional vectors) the
+ * halo layers are strided in memory. By default they are packed into a
+ * contiguous buffer before the messages are sent, i.e. the latency of the
+ * exchange includes the packing. With derived datatypes the MPI library
+ * reads the layers directly from the vector and the packing (which is still
+ * needed for the local computation) overlaps with the communication.
+ * Which one is faster depends on the MPI library and the halo size.
+@code
+dg::set_halo_packing_policy( dg::HaloPackingPolicy::derived_datatype, 0);
+dg::blas2::symv( dx, x, y); //x halos are sent with MPI_Type_vector
+@endcode
+ * @param policy the new policy
+ * @param direction 0 is x, 1 is y, 2 is z (the z-direction is always contiguous and unaffected)
+ * @note The results do not depend on the policy
+ * @ingroup mpi_structures
+ */
+inline void set_halo_packing_policy( HaloPackingPolicy policy, unsigned direction){
+    detail::halo_packing_policy().at(direction) = policy;
+}
+/**
+ * @brief Set how halo layers are sent in all directions
+ * @param policy the new policy for all directions
+ * @ingroup mpi_structures
+ */
+inline void set_halo_packing_policy( HaloPackingPolicy policy){
+    detail::halo_packing_policy().fill( policy);
+}
+/**
+ * @brief How halo layers are sent in the given direction
+ * @param direction 0 is x, 1 is y, 2 is z
+ * @return the policy set by \c dg::set_halo_packing_policy
+ * @ingroup mpi_structures
+ */
+inline HaloPackingPolicy get_halo_packing_policy( unsigned direction){
+    return detail::halo_packing_policy().at(direction);
+}
+
 /**
  * @brief Struct that performs collective scatter and gather operations across processes
  * on distributed vectors using MPI
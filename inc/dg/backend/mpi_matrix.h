@@ -137,16 +137,12 @@ struct RowColDistMat
 
         //1.1 initiate communication
         MPI_Request rqst[4];
-        const value_type * x_ptr = thrust::raw_pointer_cast(x.data().data());
-              value_type * y_ptr = thrust::raw_pointer_cast(y.data().data());
-        m_c.global_gather_init( x_ptr, m_buffer.data(), rqst);
+        symv_start( x, rqst);
         //1.2 compute inner points
         dg::blas2::symv( alpha, m_i, x.data(), beta, y.data());
         //2. wait for communication to finish
-        m_c.global_gather_wait( x_ptr, m_buffer.data(), rqst);
         //3. compute and add outer points
-        const value_type** b_ptr = thrust::raw_pointer_cast(m_buffer.data().data());
-        m_o.symv( SharedVectorTag(), get_execution_policy<ContainerType1>(), alpha, b_ptr, beta, y_ptr);
+        symv_finish( alpha, x, y, rqst);
     }
 
     /**
@@ -177,17 +173,34 @@ struct RowColDistMat
 
         //1.1 initiate communication
         MPI_Request rqst[4];
-        const value_type * x_ptr = thrust::raw_pointer_cast(x.data().data());
-              value_type * y_ptr = thrust::raw_pointer_cast(y.data().data());
-        m_c.global_gather_init( x_ptr, m_buffer.data(), rqst);
+        symv_start( x, rqst);
         //1.2 compute inner points
         dg::blas2::symv( m_i, x.data(), y.data());
         //2. wait for communication to finish
-        m_c.global_gather_wait( x_ptr, m_buffer.data(), rqst);
         //3. compute and add outer points
+        symv_finish( 1., x, y, rqst);
+    }
+    ///@cond
+    //The communication stages of symv, such that several matrices can
+    //exchange their halos at the same time (used by dg::blas2::symv_batch).
+    //Only call if collective().isCommunicating()
+    template<class ContainerType1>
+    void symv_start( const ContainerType1& x, MPI_Request rqst[4]) const
+    {
+        const value_type * x_ptr = thrust::raw_pointer_cast(x.data().data());
+        m_c.global_gather_init( x_ptr, m_buffer.data(), rqst);
+    }
+    //wait for the communication and add alpha times the outer points to y
+    template<class ContainerType1, class ContainerType2>
+    void symv_finish( value_type alpha, const ContainerType1& x, ContainerType2& y, MPI_Request rqst[4]) const
+    {
+        const value_type * x_ptr = thrust::raw_pointer_cast(x.data().data());
+              value_type * y_ptr = thrust::raw_pointer_cast(y.data().data());
+        m_c.global_gather_wait( x_ptr, m_buffer.data(), rqst);
         const value_type** b_ptr = thrust::raw_pointer_cast(m_buffer.data().data());
-        m_o.symv( SharedVectorTag(), get_execution_policy<ContainerType1>(), 1., b_ptr, 1., y_ptr);
+        m_o.symv( SharedVectorTag(), get_execution_policy<ContainerType1>(), alpha, b_ptr, 1., y_ptr);
     }
+    ///@endcond
 
     private:
     LocalMatrixInner m_i;
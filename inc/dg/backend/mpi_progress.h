@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <mpi.h>
+#include "exceptions.h"
+
+namespace dg
+{
+///@cond
+namespace detail
+{
+//A thread that calls MPI_Iprobe as long as at least one halo exchange is in
+//flight and sleeps otherwise (it never touches the requests of the exchange)
+struct ProgressThread
+{
+    ProgressThread() = default;
+    ProgressThread( const ProgressThread&) = delete;
+    ProgressThread& operator=( const ProgressThread&) = delete;
+    //the thread makes no MPI calls while it sleeps, so it can be joined
+    //even after MPI_Finalize
+    ~ProgressThread(){ stop();}
+    void start(){
+        if( m_thread.joinable()) return;
+        m_stop = false;
+        m_thread = std::thread( [this](){ run();});
+    }
+    void stop(){
+        if( !m_thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock( m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+        //exchanges still in flight end without decrementing (see end)
+        m_active = 0;
+    }
+    bool running() const{ return m_thread.joinable();}
+    //called by the main thread after the messages are posted
+    void begin(){
+        {
+            std::lock_guard<std::mutex> lock( m_mutex);
+            m_active++;
+        }
+        m_cv.notify_one();
+    }
+    //called by the main thread after the messages arrived
+    void end(){
+        std::lock_guard<std::mutex> lock( m_mutex);
+        if( m_active > 0) //the thread may have been (re)started during the exchange
+            m_active--;
+    }
+    private:
+    void run(){
+        std::unique_lock<std::mutex> lock( m_mutex);
+        while( true)
+        {
+            m_cv.wait( lock, [this](){ return m_stop || m_active > 0;});
+            if( m_stop) return;
+            lock.unlock();
+            int flag;
+            while( m_active > 0 && !m_stop)
+                MPI_Iprobe( MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_SELF, &flag,
+                        MPI_STATUS_IGNORE);
+            lock.lock();
+        }
+    }
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<int> m_active{0};
+    std::atomic<bool> m_stop{false};
+};
+inline ProgressThread& progress_thread(){
+    static ProgressThread thread;
+    return thread;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Start a thread that drives MPI progress while halo exchanges are in flight
+ *
+ * The overlap of communication and computation in e.g. \c dg::RowColDistMat
+ * (the inner points are computed while the halo messages are in flight) only
+ * works if the MPI library progresses messages in the background. Many
+ * libraries only progress messages inside MPI calls, i.e. the messages are
+ * only exchanged in \c MPI_Waitall after the inner points are computed. With
+ * this function a dedicated thread calls \c MPI_Iprobe in a loop between the
+ * start and the end of each halo exchange of \c dg::NearestNeighborComm and
+ * sleeps otherwise.
+@code
+int provided;
+MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+dg::start_progress_thread();
+// ... symv calls progress in the background
+dg::stop_progress_thread();
+MPI_Finalize();
+@endcode
+ * @note The thread occupies one core while it is active, so run with one
+ * OpenMP thread less than there are cores per process.
+ * @attention MPI must be initialized with \c MPI_THREAD_MULTIPLE
+ * @throw dg::Error if the MPI library does not provide \c MPI_THREAD_MULTIPLE
+ * @ingroup mpi_structures
+ */
+inline void start_progress_thread(){
+    int provided;
+    MPI_Query_thread( &provided);
+    if( provided < MPI_THREAD_MULTIPLE)
+        throw dg::Error( dg::Message(_ping_)<<"The progress thread needs MPI_THREAD_MULTIPLE!");
+    detail::progress_thread().start();
+}
+/**
+ * @brief Stop the thread started by \c dg::start_progress_thread
+ *
+ * Does nothing if the thread is not running
+ * @ingroup mpi_structures
+ */
+inline void stop_progress_thread(){
+    detail::progress_thread().stop();
+}
+
+}//namespace dg
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <cassert>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
 #include <thrust/host_vector.h>
 #include <thrust/gather.h>
 #include "exceptions.h"
@@ -8,6 +12,7 @@
 #include "tensor_traits.h"
 #include "blas1_dispatch_shared.h"
 #include "mpi_communicator.h"
+#include "mpi_progress.h"
 #include "memory.h"
 #include "config.h"
 
@@ -139,6 +144,219 @@ struct TensorTraits<MPI_Vector<container> > {
 ///@}
 
 /////////////////////////////communicator//////////////////////////
+///@cond
+namespace detail
+{
+//Persistent send and receive requests for the halo exchange, one set of
+//four requests for each combination of send and receive buffers.
+//Copies are empty since the buffers of a copied communicator differ.
+struct PersistentHaloRequests
+{
+    PersistentHaloRequests(){}
+    PersistentHaloRequests( const PersistentHaloRequests&){}
+    PersistentHaloRequests& operator=( const PersistentHaloRequests&){
+        clear();
+        return *this;
+    }
+    ~PersistentHaloRequests(){ clear();}
+    //return requests for the given buffers or nullptr if not yet created
+    MPI_Request* find( const std::array<const void*,4>& buffers){
+        for( auto& entry : m_entries)
+            if( entry.first == buffers)
+                return entry.second.data();
+        return nullptr;
+    }
+    //add requests for new buffers (the oldest set is freed if there are too many)
+    MPI_Request* insert( const std::array<const void*,4>& buffers){
+        if( m_entries.size() == max_entries)
+        {
+            free( m_entries.front().second);
+            m_entries.erase( m_entries.begin());
+        }
+        std::array<MPI_Request,4> rqst;
+        rqst.fill( MPI_REQUEST_NULL);
+        m_entries.push_back( {buffers, rqst});
+        return m_entries.back().second.data();
+    }
+    void clear(){
+        for( auto& entry : m_entries)
+            free( entry.second);
+        m_entries.clear();
+    }
+    private:
+    //the input vector is a send buffer if the halo is contiguous in memory,
+    //so there is one set of requests per input vector in use
+    static const unsigned max_entries = 32;
+    void free( std::array<MPI_Request,4>& rqst){
+        int finalized;
+        MPI_Finalized( &finalized);
+        if( finalized) return;
+        for( auto& r : rqst)
+            if( r != MPI_REQUEST_NULL)
+                MPI_Request_free( &r);
+    }
+    std::vector<std::pair<std::array<const void*,4>, std::array<MPI_Request,4>>> m_entries;
+};
+
+//Owns a committed MPI datatype that describes one (strided) halo layer
+//in the order in which the layer is packed; copies duplicate the type
+struct HaloLayerType
+{
+    HaloLayerType(){}
+    HaloLayerType( const HaloLayerType& src){
+        if( src.m_type != MPI_DATATYPE_NULL)
+            MPI_Type_dup( src.m_type, &m_type);
+    }
+    HaloLayerType& operator=( const HaloLayerType& src){
+        if( this != &src)
+        {
+            clear();
+            if( src.m_type != MPI_DATATYPE_NULL)
+                MPI_Type_dup( src.m_type, &m_type);
+        }
+        return *this;
+    }
+    ~HaloLayerType(){ clear();}
+    //n blocks of the given (strided) type, each block starts offset elements after the previous one
+    void construct( unsigned n, MPI_Datatype block, MPI_Aint offset){
+        clear();
+        MPI_Type_create_hvector( n, 1, offset, block, &m_type);
+        MPI_Type_commit( &m_type);
+        MPI_Type_free( &block);
+    }
+    MPI_Datatype get() const{ return m_type;}
+    bool empty() const{ return m_type == MPI_DATATYPE_NULL;}
+    void clear(){
+        int finalized;
+        MPI_Finalized( &finalized);
+        if( m_type != MPI_DATATYPE_NULL && !finalized)
+            MPI_Type_free( &m_type);
+        m_type = MPI_DATATYPE_NULL;
+    }
+    private:
+    MPI_Datatype m_type = MPI_DATATYPE_NULL;
+};
+
+#if MPI_VERSION >= 3
+//MPI-3 shared memory window that holds the first and the last layer that a
+//process sends to its -1 and +1 neighbor; neighbors on the same node read the
+//layers directly. There are two slots for the layers that are used in turn,
+//so a process can write the layers of the next exchange while its neighbors
+//still read the ones of the previous exchange. Construction and destruction
+//are collective in the communicator; the window is not copyable (copies of
+//a NearestNeighborComm share it)
+template<class value_type>
+struct SharedHaloWindow
+{
+    SharedHaloWindow( unsigned size, MPI_Comm comm, const int neighbor[2])
+    {
+        m_size = size;
+        MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm);
+        MPI_Win_allocate_shared( 4*size*sizeof(value_type), sizeof(value_type),
+                MPI_INFO_NULL, m_node_comm, &m_layers, &m_win);
+        MPI_Win_lock_all( MPI_MODE_NOCHECK, m_win);
+        //ranks of the neighbors in the node communicator (or MPI_UNDEFINED)
+        MPI_Group group, node_group;
+        MPI_Comm_group( comm, &group);
+        MPI_Comm_group( m_node_comm, &node_group);
+        MPI_Group_translate_ranks( group, 2, neighbor, node_group, m_node_neighbor);
+        MPI_Group_free( &group);
+        MPI_Group_free( &node_group);
+        for( unsigned u=0; u<2; u++)
+        {
+            m_neighbor_layers[u] = nullptr;
+            if( is_shared(u))
+            {
+                MPI_Aint bytes;
+                int disp_unit;
+                MPI_Win_shared_query( m_win, m_node_neighbor[u], &bytes,
+                        &disp_unit, &m_neighbor_layers[u]);
+            }
+        }
+        for( unsigned u=0; u<4; u++)
+            m_done[u] = MPI_REQUEST_NULL;
+    }
+    SharedHaloWindow( const SharedHaloWindow&) = delete;
+    SharedHaloWindow& operator=( const SharedHaloWindow&) = delete;
+    ~SharedHaloWindow(){
+        int finalized;
+        MPI_Finalized( &finalized);
+        if( finalized) return;
+        MPI_Waitall( 4, m_done, MPI_STATUSES_IGNORE);
+        MPI_Win_unlock_all( m_win);
+        MPI_Win_free( &m_win);
+        MPI_Comm_free( &m_node_comm);
+    }
+    //is the -1 (u=0) or +1 (u=1) neighbor on the same node
+    bool is_shared( unsigned u) const{
+        return m_node_neighbor[u] != MPI_UNDEFINED
+            && m_node_neighbor[u] != MPI_PROC_NULL;
+    }
+    //Start an exchange through the window and switch to the other slot.
+    //Returns false if another exchange (of a copy) is still in flight, then
+    //the caller must use messages (all processes take the same decision
+    //as long as they call the exchanges in the same order)
+    bool begin(){
+        if( m_busy) return false;
+        m_busy = true;
+        m_slot = 1 - m_slot;
+        return true;
+    }
+    //the last layer of the -1 neighbor
+    const value_type* lower_halo() const{ return m_neighbor_layers[0] + (2*m_slot+1)*m_size;}
+    //the first layer of the +1 neighbor
+    const value_type* upper_halo() const{ return m_neighbor_layers[1] + 2*m_slot*m_size;}
+    //Write the layers into the current slot and post the ready signals in
+    //rqst[0] and rqst[2] and their receives from the neighbors in rqst[1] and
+    //rqst[3] (the same layout as the messages in the isend_irecv exchange).
+    //Also signal the neighbors that we do not read the halos of the previous
+    //exchange any more (completed in finish)
+    void write( const value_type* first, const value_type* last, MPI_Request rqst[4])
+    {
+        int minus = is_shared(0) ? m_node_neighbor[0] : MPI_PROC_NULL;
+        int plus  = is_shared(1) ? m_node_neighbor[1] : MPI_PROC_NULL;
+        //the slot was last read two exchanges ago, which the neighbors
+        //confirmed before the previous exchange finished
+        if( is_shared(0))
+            std::copy( first, first+m_size, m_layers + 2*m_slot*m_size);
+        if( is_shared(1))
+            std::copy( last, last+m_size, m_layers + (2*m_slot+1)*m_size);
+        MPI_Win_sync( m_win);
+        MPI_Isend( nullptr, 0, MPI_BYTE, minus, 11, m_node_comm, &m_done[0]);
+        MPI_Irecv( nullptr, 0, MPI_BYTE, plus,  11, m_node_comm, &m_done[1]);
+        MPI_Isend( nullptr, 0, MPI_BYTE, plus,  12, m_node_comm, &m_done[2]);
+        MPI_Irecv( nullptr, 0, MPI_BYTE, minus, 12, m_node_comm, &m_done[3]);
+        if( is_shared(0))
+        {
+            MPI_Isend( nullptr, 0, MPI_BYTE, minus, 21, m_node_comm, &rqst[0]);
+            MPI_Irecv( nullptr, 0, MPI_BYTE, minus, 22, m_node_comm, &rqst[3]);
+        }
+        if( is_shared(1))
+        {
+            MPI_Isend( nullptr, 0, MPI_BYTE, plus, 22, m_node_comm, &rqst[2]);
+            MPI_Irecv( nullptr, 0, MPI_BYTE, plus, 21, m_node_comm, &rqst[1]);
+        }
+    }
+    //call after the ready signals arrived and before the halos are read
+    void finish(){
+        MPI_Waitall( 4, m_done, MPI_STATUSES_IGNORE);
+        MPI_Win_sync( m_win);
+        m_busy = false;
+    }
+    private:
+    unsigned m_size = 0, m_slot = 1;
+    bool m_busy = false;
+    MPI_Comm m_node_comm = MPI_COMM_NULL;
+    MPI_Win m_win = MPI_WIN_NULL;
+    value_type* m_layers = nullptr;
+    value_type* m_neighbor_layers[2] = {nullptr, nullptr};
+    int m_node_neighbor[2] = {MPI_UNDEFINED, MPI_UNDEFINED};
+    MPI_Request m_done[4];
+};
+#endif //MPI_VERSION
+}//namespace detail
+///@endcond
+
 /**
 * @brief Communicator for asynchronous nearest neighbor communication
 *
@@ -160,6 +378,10 @@ struct TensorTraits<MPI_Vector<container> > {
 *
 * The communication is done asynchronously i.e. the user can initiate
 * the communication and signal when the results are needed at a later stage.
+* The MPI calls used in the exchange are chosen at runtime with \c dg::set_halo_exchange_policy
+* and whether strided layers are packed before they are sent with \c dg::set_halo_packing_policy.
+* If the MPI library does not progress messages in the background, a thread started with
+* \c dg::start_progress_thread can do so while the exchange is in flight.
 *
 * @note If the number of neighboring processes in the given direction is 1,
 * the buffer size is 0 and all members return immediately.
@@ -302,14 +524,39 @@ struct NearestNeighborComm
             host_ptr[4] = thrust::raw_pointer_cast(&m_internal_buffer.data()[4*size]);
             host_ptr[5] = thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]);
         }
+#if MPI_VERSION >= 3
+        //neighbors on the same node give us pointers to their layers
+        m_window_in_use = use_shared_window() && m_shared->begin();
+        if( m_window_in_use)
+        {
+            if( m_shared->is_shared(0))
+                host_ptr[0] = m_shared->lower_halo();
+            if( m_shared->is_shared(1))
+                host_ptr[5] = m_shared->upper_halo();
+        }
+#endif //MPI_VERSION
         //copy pointers to device
         thrust::copy( host_ptr, host_ptr+6, buffer.begin());
-        //fill internal_buffer if !trivial
-        do_global_gather_init( get_execution_policy<Vector>(), input, rqst);
-        sendrecv( host_ptr[1], host_ptr[4],
-                  thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]), //host_ptr is const!
-                  thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]), //host_ptr is const!
-                  rqst);
+        if( use_derived_datatype())
+        {
+            //send the layers directly from input and pack while the messages are in flight
+            sendrecv( input, input+m_upper_layer,
+                      thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]),
+                      thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]),
+                      rqst, true);
+            do_global_gather_init( get_execution_policy<Vector>(), input, rqst);
+        }
+        else
+        {
+            //fill internal_buffer if !trivial
+            do_global_gather_init( get_execution_policy<Vector>(), input, rqst);
+            sendrecv( host_ptr[1], host_ptr[4],
+                      thrust::raw_pointer_cast(&m_internal_buffer.data()[0*size]), //host_ptr is const!
+                      thrust::raw_pointer_cast(&m_internal_buffer.data()[5*size]), //host_ptr is const!
+                      rqst, false);
+        }
+        if( detail::progress_thread().running())
+            detail::progress_thread().begin();
     }
     /**
     * @brief Wait for asynchronous communication to finish and gather received data into buffer
@@ -322,6 +569,15 @@ struct NearestNeighborComm
     void global_gather_wait(const_pointer_type input, const buffer_type& buffer, MPI_Request rqst[4])const
     {
         MPI_Waitall( 4, rqst, MPI_STATUSES_IGNORE );
+        if( detail::progress_thread().running())
+            detail::progress_thread().end();
+#if MPI_VERSION >= 3
+        if( m_window_in_use)
+        {
+            m_shared->finish();
+            m_window_in_use = false;
+        }
+#endif //MPI_VERSION
 #ifdef _DG_CUDA_UNAWARE_MPI
     if( std::is_same< get_execution_policy<Vector>, CudaTag>::value ) //could be serial tag
     {
@@ -341,6 +597,21 @@ struct NearestNeighborComm
     void do_global_gather_init( SerialTag, const_pointer_type, MPI_Request rqst[4])const;
     void do_global_gather_init( CudaTag, const_pointer_type, MPI_Request rqst[4])const;
     void construct( unsigned n, const unsigned vector_dimensions[3], MPI_Comm comm, unsigned direction);
+    bool use_derived_datatype() const{
+        if( m_layer_type.empty() || get_halo_packing_policy( m_direction) != HaloPackingPolicy::derived_datatype
+            || std::is_same<get_execution_policy<Vector>, CudaTag>::value)
+            return false;
+        HaloExchangePolicy policy = get_halo_exchange_policy();
+        return policy == HaloExchangePolicy::isend_irecv || policy == HaloExchangePolicy::persistent;
+    }
+#if MPI_VERSION >= 3
+    //the window exists if the communicator was constructed with the shared_window policy
+    bool use_shared_window() const{
+        return m_shared && get_halo_exchange_policy() == HaloExchangePolicy::shared_window;
+    }
+    std::shared_ptr<detail::SharedHaloWindow<get_value_type<Vector>>> m_shared; //shared among copies
+    mutable bool m_window_in_use = false; //the current exchange goes through the window
+#endif //MPI_VERSION
 
     unsigned m_n, m_dim[3]; //deepness, dimensions
     MPI_Comm m_comm;
@@ -354,8 +625,15 @@ struct NearestNeighborComm
     dg::Buffer<thrust::host_vector<get_value_type<Vector>>> m_internal_host_buffer;
 #endif
 
-    void sendrecv(const_pointer_type, const_pointer_type, pointer_type, pointer_type, MPI_Request rqst[4])const;
+    void sendrecv(const_pointer_type, const_pointer_type, pointer_type, pointer_type, MPI_Request rqst[4], bool derived)const;
+    detail::HaloLayerType m_layer_type; //strided layers only
+    unsigned m_upper_layer = 0; //start of the last layer in input
     int m_source[2], m_dest[2];
+    mutable detail::PersistentHaloRequests m_persistent;
+    //arguments of MPI_Ineighbor_alltoallw (must live until the exchange is finished)
+    mutable std::vector<int> m_send_counts, m_recv_counts;
+    mutable std::vector<MPI_Aint> m_send_displs, m_recv_displs;
+    mutable std::vector<MPI_Datatype> m_send_types, m_recv_types;
 };
 
 ///@cond
@@ -383,6 +661,14 @@ void NearestNeighborComm<I,B,V>::construct( unsigned n, const unsigned dimension
         int dims[ndims], periods[ndims], coords[ndims];
         MPI_Cart_get( comm, ndims, dims, periods, coords);
         if( dims[direction] == 1) m_silent = true;
+        //the neighbors of a Cartesian topology are ordered (-1,+1) in each dimension
+        //all other neighbors get zero counts
+        m_send_counts.assign( 2*ndims, 0);
+        m_recv_counts.assign( 2*ndims, 0);
+        m_send_displs.assign( 2*ndims, 0);
+        m_recv_displs.assign( 2*ndims, 0);
+        m_send_types.assign( 2*ndims, getMPIDataType<get_value_type<V>>());
+        m_recv_types.assign( 2*ndims, getMPIDataType<get_value_type<V>>());
     }
     if( !m_silent)
     {
@@ -428,7 +714,33 @@ void NearestNeighborComm<I,B,V>::construct( unsigned n, const unsigned dimension
 #ifdef _DG_CUDA_UNAWARE_MPI
     m_internal_host_buffer.data().resize( 6*buffer_size() );
 #endif
+    //the layers in the order of mid_gather
+    MPI_Datatype block;
+    MPI_Aint extent = sizeof(get_value_type<V>);
+    if( direction == 0)
+    {
+        MPI_Type_vector( m_dim[2]*m_dim[1], 1, m_dim[0], getMPIDataType<get_value_type<V>>(), &block);
+        m_layer_type.construct( n, block, extent);
+        m_upper_layer = m_dim[0]-n;
+    }
+    else if( !m_trivial)
+    {
+        MPI_Type_vector( m_dim[2], m_dim[0], m_dim[1]*m_dim[0], getMPIDataType<get_value_type<V>>(), &block);
+        m_layer_type.construct( n, block, m_dim[0]*extent);
+        m_upper_layer = (m_dim[1]-n)*m_dim[0];
     }
+    m_recv_counts[2*direction] = m_recv_counts[2*direction+1] = buffer_size();
+    }
+    m_persistent.clear();
+#if MPI_VERSION >= 3
+    //creating the window is collective, so it cannot wait until the first exchange
+    m_shared.reset();
+    m_window_in_use = false;
+    if( !m_silent && get_halo_exchange_policy() == HaloExchangePolicy::shared_window
+        && !std::is_same<get_execution_policy<V>, CudaTag>::value)
+        m_shared = std::make_shared<detail::SharedHaloWindow<get_value_type<V>>>(
+            buffer_size(), m_comm, m_dest);
+#endif //MPI_VERSION
 }
 
 template<class I, class B, class V>
@@ -486,9 +798,12 @@ void NearestNeighborComm<I,B,V>::do_global_gather_init( CudaTag, const_pointer_t
 #endif
 
 template<class I, class B, class V>
-void NearestNeighborComm<I,B,V>::sendrecv( const_pointer_type sb1_ptr, const_pointer_type sb2_ptr, pointer_type rb1_ptr, pointer_type rb2_ptr, MPI_Request rqst[4]) const
+void NearestNeighborComm<I,B,V>::sendrecv( const_pointer_type sb1_ptr, const_pointer_type sb2_ptr, pointer_type rb1_ptr, pointer_type rb2_ptr, MPI_Request rqst[4], bool derived) const
 {
     unsigned size = buffer_size();
+    //a strided layer is one element of the layer type
+    int send_count = derived ? 1 : size;
+    MPI_Datatype send_type = derived ? m_layer_type.get() : getMPIDataType<get_value_type<V>>();
 #ifdef _DG_CUDA_UNAWARE_MPI
     if( std::is_same< get_execution_policy<V>, CudaTag>::value ) //could be serial tag
     {
@@ -503,15 +818,82 @@ void NearestNeighborComm<I,B,V>::sendrecv( const_pointer_type sb1_ptr, const_poi
     }
 //This is a mistake if called with a host_vector
 #endif
-    MPI_Isend( sb1_ptr, size,
-               getMPIDataType<get_value_type<V>>(),  //sender
+    HaloExchangePolicy policy = get_halo_exchange_policy();
+    if( policy == HaloExchangePolicy::persistent)
+    {
+        std::array<const void*,4> buffers = {sb1_ptr, sb2_ptr, rb1_ptr, rb2_ptr};
+        MPI_Request* persistent = m_persistent.find( buffers);
+        if( persistent == nullptr)
+        {
+            persistent = m_persistent.insert( buffers);
+            MPI_Send_init( sb1_ptr, send_count, send_type,
+                       m_dest[0], 3, m_comm, &persistent[0]);
+            MPI_Recv_init( rb2_ptr, size, getMPIDataType<get_value_type<V>>(),
+                       m_source[0], 3, m_comm, &persistent[1]);
+            MPI_Send_init( sb2_ptr, send_count, send_type,
+                       m_dest[1], 9, m_comm, &persistent[2]);
+            MPI_Recv_init( rb1_ptr, size, getMPIDataType<get_value_type<V>>(),
+                       m_source[1], 9, m_comm, &persistent[3]);
+        }
+        MPI_Startall( 4, persistent);
+        //MPI_Waitall leaves persistent requests allocated
+        for( unsigned i=0; i<4; i++)
+            rqst[i] = persistent[i];
+        return;
+    }
+#if MPI_VERSION >= 3
+    if( m_window_in_use)
+    {
+        rqst[0] = rqst[1] = rqst[2] = rqst[3] = MPI_REQUEST_NULL;
+        m_shared->write( sb1_ptr, sb2_ptr, rqst);
+        //neighbors on other nodes
+        if( !m_shared->is_shared(0))
+        {
+            MPI_Isend( sb1_ptr, size, getMPIDataType<get_value_type<V>>(),
+                       m_dest[0], 3, m_comm, &rqst[0]);
+            MPI_Irecv( rb1_ptr, size, getMPIDataType<get_value_type<V>>(),
+                       m_source[1], 9, m_comm, &rqst[3]);
+        }
+        if( !m_shared->is_shared(1))
+        {
+            MPI_Irecv( rb2_ptr, size, getMPIDataType<get_value_type<V>>(),
+                       m_source[0], 3, m_comm, &rqst[1]);
+            MPI_Isend( sb2_ptr, size, getMPIDataType<get_value_type<V>>(),
+                       m_dest[1], 9, m_comm, &rqst[2]);
+        }
+        return;
+    }
+    //If both neighbors are the same process (periodic with two processes)
+    //some MPI libraries confuse the two messages of the neighborhood collective
+    if( policy == HaloExchangePolicy::neighbor_alltoallw && m_dest[0] != m_dest[1])
+    {
+        //send the first layer to and receive the lower halo from the -1 neighbor
+        //and the last layer and upper halo with the +1 neighbor
+        //The buffers are separate allocations, so we give absolute addresses relative to MPI_BOTTOM
+        unsigned lower = 2*m_direction, upper = 2*m_direction+1;
+        m_send_counts[lower] = m_send_counts[upper] = send_count;
+        m_send_types[lower] = m_send_types[upper] = send_type;
+        MPI_Get_address( sb1_ptr, &m_send_displs[lower]);
+        MPI_Get_address( sb2_ptr, &m_send_displs[upper]);
+        MPI_Get_address( rb1_ptr, &m_recv_displs[lower]);
+        MPI_Get_address( rb2_ptr, &m_recv_displs[upper]);
+        MPI_Ineighbor_alltoallw(
+            MPI_BOTTOM, m_send_counts.data(), m_send_displs.data(), m_send_types.data(),
+            MPI_BOTTOM, m_recv_counts.data(), m_recv_displs.data(), m_recv_types.data(),
+            m_comm, &rqst[0]);
+        rqst[1] = rqst[2] = rqst[3] = MPI_REQUEST_NULL;
+        return;
+    }
+#endif //MPI_VERSION
+    MPI_Isend( sb1_ptr, send_count,
+               send_type,  //sender
                m_dest[0], 3, m_comm, &rqst[0]); //destination
     MPI_Irecv( rb2_ptr, size,
                getMPIDataType<get_value_type<V>>(), //receiver
                m_source[0], 3, m_comm, &rqst[1]); //source
 
-    MPI_Isend( sb2_ptr, size,
-               getMPIDataType<get_value_type<V>>(),  //sender
+    MPI_Isend( sb2_ptr, send_count,
+               send_type,  //sender
                m_dest[1], 9, m_comm, &rqst[2]);  //destination
     MPI_Irecv( rb1_ptr, size,
                getMPIDataType<get_value_type<V>>(), //receiver
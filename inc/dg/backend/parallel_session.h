@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <exception>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+
+namespace dg
+{
+///@cond
+namespace detail
+{
+inline bool& parallel_session_flag(){
+    static bool active = false;
+    return active;
+}
+//shared array of one pointer per thread for the reductions inside a session
+inline std::vector<const int64_t*>& parallel_session_pointers(){
+    static std::vector<const int64_t*> pointers;
+    return pointers;
+}
+//shared array of one error status per thread for the reductions inside a session
+inline std::vector<int>& parallel_session_status(){
+    static std::vector<int> status;
+    return status;
+}
+//true if called by a thread of the team of a dg::parallel_session
+inline bool in_parallel_session(){
+#ifdef _OPENMP
+    return parallel_session_flag() && omp_in_parallel();
+#else
+    return false;
+#endif //_OPENMP
+}
+//all threads of a session wait until the previous kernel is finished
+inline void parallel_session_barrier(){
+#ifdef _OPENMP
+    if( in_parallel_session())
+    {
+        #pragma omp barrier
+    }
+#endif //_OPENMP
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Execute \c f inside a single OpenMP parallel region
+ *
+ * Normally every \c dg::blas1 and \c dg::blas2 function on an OpenMP
+ * container opens and closes its own parallel region. Inside a parallel
+ * session all threads execute \c f and every blas function shares its work
+ * among the threads of the session (with orphaned <tt> omp for </tt>
+ * constructs followed by a barrier) instead. This removes the fork/join
+ * overhead of each call, which is significant for many small kernels (e.g.
+ * the right hand side evaluation of a moderately sized 2d problem on a
+ * many-core node). Scalar products are computed cooperatively and all
+ * threads obtain the same (binary reproducible) result.
+@code
+dg::DVec x(1000,1.), y(1000,2.);
+double norm;
+dg::parallel_session( [&](){
+    dg::blas1::axpby( 1., x, 2., y);
+    norm = dg::blas1::dot( x,y); //every thread computes the same norm
+    dg::blas1::scal( y, 1./norm);
+});
+@endcode
+ * @attention Since every thread executes \c f, all containers used in blas
+ * functions must be shared among the threads (i.e. captured by reference or
+ * members of shared objects); containers that are local variables of \c f
+ * are private to each thread and must not be used in blas functions. Every
+ * thread must call the same sequence of blas functions (do not put them
+ * inside \c omp \c single or \c omp \c master constructs). Only shared
+ * memory containers with the \c OmpTag execution policy are supported: host
+ * containers (e.g. \c dg::HVec or \c std::array<double,2>) and their
+ * matrices are executed by every thread again and race on their output
+ * (debug builds assert this in \c dg::blas1), and MPI communication is not
+ * allowed inside a session.
+ * @note Exceptions that \c f throws on all threads at the same point are
+ * rethrown by \c parallel_session after the parallel region is closed. This
+ * includes the exceptions of the blas functions (e.g. a scalar product of a
+ * vector that contains NaN throws on all threads). An exception thrown by
+ * only some of the threads while the others wait in a blas function deadlocks
+ * the program.
+ * @note If \c f is called when a session or another OpenMP parallel region
+ * is already active or if OpenMP is not available, then \c f is simply called
+ * @param f a function or functor with signature <tt> void f() </tt>
+ * @ingroup dispatch
+ */
+template<class Functor>
+void parallel_session( Functor&& f)
+{
+#ifdef _OPENMP
+    if( detail::parallel_session_flag() || omp_in_parallel())
+    {
+        f();
+        return;
+    }
+    detail::parallel_session_flag() = true;
+    detail::parallel_session_pointers().resize( omp_get_max_threads());
+    detail::parallel_session_status().resize( omp_get_max_threads());
+    //an exception must not leave the parallel region
+    std::exception_ptr error = nullptr;
+    #pragma omp parallel
+    {
+        try{
+            f();
+        }
+        catch( ...)
+        {
+            #pragma omp critical( dg_parallel_session)
+            if( !error)
+                error = std::current_exception();
+        }
+    }
+    detail::parallel_session_flag() = false;
+    if( error)
+        std::rethrow_exception( error);
+#else
+    f();
+#endif //_OPENMP
+}
+
+}//namespace dg
@@ -3,6 +3,7 @@
 #include <thrust/device_vector.h>
 //#include <cusp/system/cuda/utils.h>
 #include "sparseblockmat.h"
+#include "parallel_session.h"
 
 namespace dg
 {
@@ -162,6 +163,7 @@ inline void EllSparseBlockMatDevice<value_type>::symv(SharedVectorTag, OmpTag, v
         return;
     }
     launch_multiply_kernel(alpha, x, beta, y);
+    dg::detail::parallel_session_barrier();
 }
 
 template<class value_type>
@@ -178,6 +180,7 @@ inline void CooSparseBlockMatDevice<value_type>::symv(SharedVectorTag, OmpTag, v
         return;
     }
     launch_multiply_kernel(alpha, x, beta, y);
+    dg::detail::parallel_session_barrier();
 }
 #endif //_OPENMP
 
@@ -55,6 +55,103 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
         }
     }
 }
+//number of value_type elements that fit into one SIMD register of the host
+template<class value_type>
+constexpr int ell_simd_width()
+{
+#if defined(__AVX512F__)
+    return 64/sizeof(value_type);
+#elif defined(__AVX__)
+    return 32/sizeof(value_type);
+#else
+    return 16/sizeof(value_type);
+#endif
+}
+
+//copy all n*n blocks of row i into dprivate and compute the column offsets J
+template<class value_type, int n, int blocks_per_line>
+inline void ell_load_row( int s, int i, int num_cols,
+         const value_type * RESTRICT data, const int * RESTRICT cols_idx,
+         const int * RESTRICT data_idx,
+         int* J, value_type* dprivate)
+{
+    for( int d=0; d<blocks_per_line; d++)
+    {
+        J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+        int B = data_idx[i*blocks_per_line+d]*n*n;
+        for( int kq=0; kq<n*n; kq++)
+            dprivate[d*n*n+kq] = data[B+kq];
+    }
+}
+
+//apply the blocks of one row to the c-th chunk of the right range
+//(the order of operations per element is the same as in the serial version)
+template<class value_type, int n, int blocks_per_line>
+inline void ell_multiply_chunk( value_type alpha, value_type beta,
+         const value_type * RESTRICT dprivate, const int * RESTRICT J,
+         const int row_offset, const int right_size,
+         const int * RESTRICT right_range, const int c,
+         const value_type * RESTRICT x, value_type * RESTRICT y)
+{
+    constexpr int W = ell_simd_width<value_type>();
+    const int j0 = right_range[0] + c*W;
+    if( j0 + W <= right_range[1]) //full chunk: fixed trip count
+    {
+        for( int k=0; k<n; k++)
+        {
+            value_type * RESTRICT yk = &y[row_offset + k*right_size + j0];
+            value_type yprivate[W];
+            #ifndef _MSC_VER
+            #pragma omp SIMD
+            #endif
+            for( int w=0; w<W; w++)
+                yprivate[w] = yk[w]*beta;
+            for( int d=0; d<blocks_per_line; d++)
+            {
+                value_type temp[W] = {0};
+                for( int q=0; q<n; q++) //multiplication-loop
+                {
+                    const value_type dd = dprivate[(d*n+k)*n+q];
+                    const value_type * RESTRICT xq = &x[(J[d]+q)*right_size+j0];
+                    #ifndef _MSC_VER
+                    #pragma omp SIMD
+                    #endif
+                    for( int w=0; w<W; w++)
+                        temp[w] = DG_FMA( dd, xq[w], temp[w]);
+                }
+                #ifndef _MSC_VER
+                #pragma omp SIMD
+                #endif
+                for( int w=0; w<W; w++)
+                    yprivate[w] = DG_FMA(alpha, temp[w], yprivate[w]);
+            }
+            #ifndef _MSC_VER
+            #pragma omp SIMD
+            #endif
+            for( int w=0; w<W; w++)
+                yk[w] = yprivate[w];
+        }
+    }
+    else //remainder
+    {
+        for( int k=0; k<n; k++)
+        for( int j=j0; j<right_range[1]; j++)
+        {
+            int I = row_offset + k*right_size + j;
+            y[I]*= beta;
+            for( int d=0; d<blocks_per_line; d++)
+            {
+                value_type temp = 0;
+                for( int q=0; q<n; q++) //multiplication-loop
+                    temp = DG_FMA( dprivate[(d*n+k)*n+q],
+                                x[(J[d]+q)*right_size+j],
+                                temp);
+                y[I] = DG_FMA(alpha, temp, y[I]);
+            }
+        }
+    }
+}
+
 //specialized multiply kernel
 template<class value_type, int n, int blocks_per_line>
 void ell_multiply_kernel( value_type alpha, value_type beta,
@@ -193,79 +290,54 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
     }// right_size==1
     else // right_size != 1
     {
-    value_type dprivate[blocks_per_line*n];
+    //the n*n*blocks_per_line data blocks of a row are kept in registers and
+    //the contiguous j-range is processed in chunks of ell_simd_width lanes
+    //such that the x values of a chunk are reused for all k
+    value_type dprivate[blocks_per_line*n*n];
     int J[blocks_per_line];
     if( !( (right_range[1]-right_range[0]) > 100*left_size*num_rows*n )) //typically a derivative in y ( Ny*Nz >~ Nx)
     {
-        #pragma omp for nowait
-        for (int sik = 0; sik < left_size*num_rows*n; sik++)
+        const int chunks = (right_range[1]-right_range[0]+
+                ell_simd_width<value_type>()-1)/ell_simd_width<value_type>();
+        //the row is only reloaded when it changes (consecutive iterations
+        //of a thread mostly belong to the same row)
+        int loaded = -1;
+        #pragma omp for nowait //manual collapse(2)
+        for (int sic = 0; sic < left_size*num_rows*chunks; sic++)
         {
-            int s = sik / (num_rows*n);
-            int i = (sik % (num_rows*n)) / n;
-            int k = (sik % (num_rows*n)) % n;
-
-            for( int d=0; d<blocks_per_line; d++)
+            int si = sic / chunks;
+            int c = sic % chunks;
+            int s = si / num_rows;
+            int i = si % num_rows;
+            if( si != loaded)
             {
-                J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                for(int q=0; q<n; q++)
-                    dprivate[d*n+q] = data[B+q];
-            }
-            #ifndef _MSC_VER
-            #pragma omp SIMD //very important for KNL
-            #endif
-            for( int j=right_range[0]; j<right_range[1]; j++)
-            {
-                int I = ((s*num_rows + i)*n+k)*right_size+j;
-                y[I]*= beta;
-                for( int d=0; d<blocks_per_line; d++)
-                {
-                    value_type temp = 0;
-                    int Jd = J[d];
-                    for( int q=0; q<n; q++) //multiplication-loop
-                        temp = DG_FMA( dprivate[ d*n+q],
-                                    x[(Jd+q)*right_size+j],
-                                    temp);
-                    y[I] = DG_FMA(alpha, temp, y[I]);
-                }
+                ell_load_row<value_type, n, blocks_per_line>( s, i, num_cols,
+                        data, cols_idx, data_idx, J, dprivate);
+                loaded = si;
             }
+            ell_multiply_chunk<value_type, n, blocks_per_line>( alpha,
+                beta, dprivate, J, ((s*num_rows+i)*n)*right_size,
+                right_size, right_range, c, x, y);
         }
     }
     else //typically a derivative in z (since n*n*Nx*Ny > 100*Nz)
     {
-
-        for (int sik = 0; sik < left_size*num_rows*n; sik++)
+        const int chunks = (right_range[1]-right_range[0]+
+                ell_simd_width<value_type>()-1)/ell_simd_width<value_type>();
+        for (int si = 0; si < left_size*num_rows; si++)
         {
-            int s = sik / (num_rows*n);
-            int i = (sik % (num_rows*n)) / n;
-            int k = (sik % (num_rows*n)) % n;
-
-            for( int d=0; d<blocks_per_line; d++)
-            {
-                J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                for(int q=0; q<n; q++)
-                    dprivate[d*n+q] = data[B+q];
-            }
-            #pragma omp for SIMD nowait
-            for( int j=right_range[0]; j<right_range[1]; j++)
-            {
-                int I = ((s*num_rows + i)*n+k)*right_size+j;
-                y[I]*= beta;
-                for( int d=0; d<blocks_per_line; d++)
-                {
-                    value_type temp = 0;
-                    int Jd = J[d];
-                    for( int q=0; q<n; q++) //multiplication-loop
-                        temp = DG_FMA( dprivate[ d*n+q],
-                                    x[(Jd+q)*right_size+j],
-                                    temp);
-                    y[I] = DG_FMA(alpha, temp, y[I]);
-                }
-            }
-        }
+            int s = si / num_rows;
+            int i = si % num_rows;
+            ell_load_row<value_type, n, blocks_per_line>( s, i, num_cols,
+                    data, cols_idx, data_idx, J, dprivate);
+            #pragma omp for nowait
+            for( int c=0; c<chunks; c++)
+                ell_multiply_chunk<value_type, n, blocks_per_line>( alpha,
+                    beta, dprivate, J, ((s*num_rows+i)*n)*right_size,
+                    right_size, right_range, c, x, y);
         }
     }
+    }
 }
 
 template<class value_type, int n>
@@ -0,0 +1,41 @@
+#include <iostream>
+#include <cmath>
+#include <string>
+
+#include "dg/blas.h"
+#include "dg/topology/derivatives.h"
+#include "dg/topology/evaluation.h"
+
+double sine( double x, double y, double z) { return sin(x)*sin(y)*sin(z);}
+
+int main()
+{
+    std::cout << "This program compares the device (OpenMP or CUDA) kernels of EllSparseBlockMat with the serial symv\n";
+    //odd sizes such that the SIMD chunks of the OpenMP kernel have a remainder
+    //dz on the flat grid runs the z-branch of the OpenMP kernel, dy the y-branch
+    unsigned Nx[] = {7, 23}, Ny[] = {5, 21}, Nz[] = {9, 3};
+    for( unsigned n=1; n<7; n++)
+    for( unsigned u=0; u<2; u++)
+    {
+        dg::Grid3d g3d( 0, M_PI, 0.1, 2.*M_PI+0.1, M_PI/2., M_PI, n, Nx[u], Ny[u], Nz[u], dg::DIR, dg::PER, dg::NEU_DIR);
+        std::cout << "On Grid "<<n<<" x "<<Nx[u]<<" x "<<Ny[u]<<" x "<<Nz[u]<<"\n";
+        const dg::HVec hx = dg::evaluate( sine, g3d);
+        const dg::DVec dx = hx;
+        dg::HMatrix hm[] = {dg::create::dx( g3d, dg::forward), dg::create::dy( g3d, dg::centered),
+            dg::create::dz( g3d, dg::backward), dg::create::jumpY( g3d), dg::create::jumpZ( g3d)};
+        std::string names[] = {"DX", "DY", "DZ", "JY", "JZ"};
+        for( unsigned i=0; i<5; i++)
+        {
+            dg::DMatrix dm = hm[i];
+            dg::HVec hy( hx.size(), 1.), result( hx.size());
+            dg::DVec dy( dx.size(), 1.);
+            dg::blas2::symv( 0.5, hm[i], hx, 2., hy);
+            dg::blas2::symv( 0.5, dm, dx, 2., dy);
+            dg::assign( dy, result);
+            dg::blas1::axpby( 1., hy, -1., result);
+            double norm = sqrt( dg::blas1::dot( result, result));
+            std::cout << "    "<<names[i]<<" Difference to serial symv: "<<norm<<"\t"<<(norm == 0 ? "PASSED" : "FAILED")<<"\n";
+        }
+    }
+    return 0;
+}
@@ -27,9 +27,9 @@ struct TensorTraits<thrust::host_vector<T> >//, std::enable_if_t< std::is_arithm
 //    using execution_policy  = get_execution_policy<T>;
 //};
 
-///@brief prototypical Shared Vector with Cuda or Omp Tag
-template<class T>
-struct TensorTraits<thrust::device_vector<T> >//, std::enable_if_t<std::is_arithmetic<T>::value>>
+///@brief prototypical Shared Vector with Cuda or Omp Tag (with any allocator e.g. dg::FirstTouchAllocator)
+template<class T, class Allocator>
+struct TensorTraits<thrust::device_vector<T, Allocator> >//, std::enable_if_t<std::is_arithmetic<T>::value>>
 {
     using value_type        = T;
     using tensor_category   = ThrustVectorTag;
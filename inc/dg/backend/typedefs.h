@@ -4,6 +4,7 @@
 #include <thrust/device_vector.h>
 #include "sparseblockmat.h"
 #include "sparseblockmat.cuh"
+#include "first_touch.h"
 
 /*! @file
   @brief Useful typedefs of commonly used types.
@@ -23,6 +24,8 @@ using fHVec = thrust::host_vector<float>; //!< Host Vector
 using DVec  = thrust::device_vector<double>; //!< Device Vector. The device can be an OpenMP parallelized cpu or a gpu. This depends on the value of the macro THRUST_DEVICE_SYSTEM, which can be either THRUST_DEVICE_SYSTEM_OMP for openMP or THRUST_DEVICE_SYSTEM_CUDA for a gpu.
 using iDVec = thrust::device_vector<int>; //!< integer Device Vector
 using fDVec = thrust::device_vector<float>; //!< Device Vector. The device can be an OpenMP parallelized cpu or a gpu. This depends on the value of the macro THRUST_DEVICE_SYSTEM, which can be either THRUST_DEVICE_SYSTEM_OMP for openMP or THRUST_DEVICE_SYSTEM_CUDA for a gpu.
+using NumaDVec  = thrust::device_vector<double, FirstTouchAllocator<double>>; //!< Device Vector with NUMA-aware first touch allocation (s.a. dg::FirstTouchAllocator)
+using fNumaDVec = thrust::device_vector<float, FirstTouchAllocator<float>>; //!< Device Vector with NUMA-aware first touch allocation (s.a. dg::FirstTouchAllocator)
 
 //derivative matrices
 template<class T>
@@ -48,6 +51,8 @@ using MHVec     = dg::MPI_Vector<dg::HVec >; //!< MPI Host Vector s.a. dg::HVec
 using fMHVec    = dg::MPI_Vector<dg::fHVec >; //!< MPI Host Vector s.a. dg::fHVec
 using MDVec     = dg::MPI_Vector<dg::DVec >; //!< MPI Device Vector s.a. dg::DVec
 using fMDVec    = dg::MPI_Vector<dg::fDVec >; //!< MPI Device Vector s.a. dg::fDVec
+using MNumaDVec  = dg::MPI_Vector<dg::NumaDVec >; //!< MPI Device Vector s.a. dg::NumaDVec
+using fMNumaDVec = dg::MPI_Vector<dg::fNumaDVec >; //!< MPI Device Vector s.a. dg::fNumaDVec
 
 template<class T>
 using NNCH = dg::NearestNeighborComm<dg::iHVec, thrust::host_vector<const T*>, thrust::host_vector<T> >; //!< host Communicator for the use in an mpi matrix for derivatives
@@ -88,6 +93,8 @@ using fHVec = fMHVec;
 
 using DVec  = MDVec;
 using fDVec = fMDVec;
+using NumaDVec  = MNumaDVec;
+using fNumaDVec = fMNumaDVec;
 
 //derivative matrices
 using HMatrix = MHMatrix;
@@ -100,6 +107,8 @@ using fHVec = fHVec;
 
 using DVec  = DVec;
 using fDVec = fDVec;
+using NumaDVec  = NumaDVec;
+using fNumaDVec = fNumaDVec;
 
 //derivative matrices
 using HMatrix = HMatrix;
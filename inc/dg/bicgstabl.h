@@ -158,8 +158,11 @@ unsigned BICGSTABl< ContainerType>::solve( Matrix& A, ContainerType0& x, const C
                 tau[i][j] = 1.0/sigma[i]*dg::blas1::dot(rhat[j],rhat[i]);
                 dg::blas1::axpby(-tau[i][j],rhat[i],1.,rhat[j]);
             }
-            sigma[j] = dg::blas1::dot(rhat[j],rhat[j]);
-            gammap[j] = 1.0/sigma[j]*dg::blas1::dot(rhat[0],rhat[j]);
+            std::vector<value_type> dots = dg::blas1::dot_batch(
+                std::vector<const ContainerType*>{&rhat[j], &rhat[0]},
+                std::vector<const ContainerType*>{&rhat[j], &rhat[j]});
+            sigma[j] = dots[0];
+            gammap[j] = 1.0/sigma[j]*dots[1];
         }
 
         gamma[l] = gammap[l];
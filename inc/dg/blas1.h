@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cassert>
+#include <tuple>
+#include <utility>
 #include "backend/predicate.h"
 #include "backend/tensor_traits.h"
 #include "backend/tensor_traits_scalar.h"
@@ -15,6 +18,7 @@
 #include "backend/blas1_dispatch_mpi.h"
 #endif
 #include "backend/blas1_dispatch_vector.h"
+#include "backend/parallel_session.h"
 #include "subroutines.h"
 
 /*!@file
@@ -90,6 +94,45 @@ inline get_value_type<ContainerType1> dot( const ContainerType1& x, const Contai
     return exblas::cpu::Round(acc.data());
 }
 
+/*! @brief \f$ x_k^T y_k\f$ Several binary reproducible dot products at once
+ *
+ * This routine computes \f[ s_k = x_k^T y_k = \sum_{i=0}^{N-1} x_{k,i} y_{k,i} \f]
+ * for \f$ k = 0,\dots, K-1\f$ where \f$ K\f$ is the size of \c x.
+ * The result is bitwise identical to calling \c dg::blas1::dot on each pair,
+ * but all products are accumulated in one sweep through memory (a vector that
+ * appears in several pairs is read only once) and with MPI the \f$ K\f$
+ * superaccumulators are reduced in one single collective call. Use this
+ * function whenever several independent scalar products are needed, which
+ * saves both memory bandwidth and latency.
+ *
+For example
+@code
+dg::DVec two( 100,2), three(100,3);
+std::vector<const dg::DVec*> x = {&two, &two}, y = {&two, &three};
+std::vector<double> result = dg::blas1::dot_batch( x, y); // result = {400, 600}
+@endcode
+ * @param x pointers to the left Containers
+ * @param y pointers to the right Containers (same size as \c x), may alias \c x
+ * @return Scalar products as defined above (empty if \c x is empty)
+ * @note This routine is always executed synchronously due to the
+        implicit memcpy of the result. With mpi the result is broadcasted to all processes.
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType1, class ContainerType2>
+inline std::vector<get_value_type<ContainerType1>> dot_batch( const std::vector<const ContainerType1*>& x, const std::vector<const ContainerType2*>& y)
+{
+#ifdef DG_DEBUG
+    assert( x.size() == y.size());
+#endif //DG_DEBUG
+    std::vector<get_value_type<ContainerType1>> result( x.size());
+    if( x.empty())
+        return result;
+    std::vector<int64_t> acc = dg::blas1::detail::doDot_superacc_batch( x,y);
+    for( unsigned k=0; k<x.size(); k++)
+        result[k] = exblas::cpu::Round(&acc[k*exblas::BIN_COUNT]);
+    return result;
+}
+
 /*! @brief \f$ x_0 \otimes x_1 \otimes \dots \otimes x_{N-1} \f$ Custom reduction
  *
  * This routine computes \f[ s = s_0 + x_0 \otimes x_1 \otimes \dots \otimes x_i \otimes \dots \otimes x_{N-1} \f]
@@ -558,9 +601,175 @@ inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const Conta
     return doDot_superacc( x, y, tensor_category());
 }
 
+template< class ContainerType1, class ContainerType2>
+inline std::vector<int64_t> doDot_superacc_batch( const std::vector<const ContainerType1*>& x, const std::vector<const ContainerType2*>& y)
+{
+    static_assert( all_true<
+            dg::is_vector<ContainerType1>::value,
+            dg::is_vector<ContainerType2>::value>::value,
+        "All container types must have a vector data layout (AnyVector)!");
+    using tensor_category  = get_tensor_category<ContainerType1>;
+    static_assert( dg::is_scalar_or_same_base_category<ContainerType2, tensor_category>::value,
+        "All container types must have compatible Vector categories (AnyVector or Same base class)!");
+    return doDot_superacc_batch( x, y, tensor_category());
+}
+
+template< class ContainerType1, class ContainerType2>
+inline std::vector<int64_t> doDot_superacc_local( const ContainerType1& x, const ContainerType2& y)
+{
+    using vector_type = find_if_t<dg::is_not_scalar, ContainerType1, ContainerType1, ContainerType2>;
+    return doDot_superacc_local( x, y, get_tensor_category<vector_type>());
+}
+
+// Reduce a number of local superaccumulators (from doDot_superacc_local)
+// among all processes that share the container; with MPI the reduction is
+// a nonblocking collective that is completed in wait
+// The object must not be copied or destroyed between start and wait
+template<class ContainerType>
+struct SuperaccReduction
+{
+    // acc contains the superaccumulators one after the other (is swapped)
+    void start( const ContainerType& x, std::vector<int64_t>& acc)
+    {
+        m_num = acc.size()/exblas::BIN_COUNT;
+        m_in.swap( acc);
+        m_out.resize( m_in.size());
+        do_start( x, get_tensor_category<ContainerType>());
+    }
+    // return the (unnormalized) reduced superaccumulators
+    std::vector<int64_t>& wait()
+    {
+        do_wait( get_tensor_category<ContainerType>());
+        return m_out;
+    }
+    private:
+    void do_start( const ContainerType& x, AnyVectorTag){
+        m_out.swap( m_in);
+    }
+    void do_wait( AnyVectorTag){ }
+#ifdef MPI_VERSION
+    void do_start( const ContainerType& x, MPIVectorTag){
+        m_comm = x.communicator();
+        m_comm_mod = x.communicator_mod();
+        m_comm_red = x.communicator_mod_reduce();
+        //the scheme may change before wait is called
+        m_single = exblas::get_mpi_reduction_scheme() == exblas::MPIReductionScheme::single_allreduce;
+        if( m_single)
+            exblas::iallreduce_mpi_cpu( m_num, m_in.data(), m_out.data(), m_comm, &m_request);
+        else
+            exblas::ireduce_mpi_cpu( m_num, m_in.data(), m_out.data(), m_comm_mod, &m_request);
+    }
+    void do_wait( MPIVectorTag){
+        if( m_single)
+            MPI_Wait( &m_request, MPI_STATUS_IGNORE);
+        else
+            exblas::ireduce_mpi_cpu_wait( m_num, m_in.data(), m_out.data(), m_comm, m_comm_mod, m_comm_red, &m_request);
+    }
+    MPI_Comm m_comm, m_comm_mod, m_comm_red;
+    MPI_Request m_request;
+    bool m_single = false;
+#endif //MPI_VERSION
+    unsigned m_num = 0;
+    std::vector<int64_t> m_in, m_out;
+};
+
 }//namespace detail
 ///@endcond
 
+/**
+ * @brief A scalar product whose reduction among processes may still be in flight
+ *
+ * Objects of this class are returned by \c dg::blas1::dot_async. The local
+ * part of the scalar product is already computed at construction, so the
+ * input vectors may be changed right away. With MPI the superaccumulators
+ * are summed with a nonblocking collective that is only completed in \c get,
+ * which allows to overlap the global reduction with useful work. Without MPI
+ * the result is available immediately.
+ * @note The object can be moved but not copied. If it is destroyed before
+ * \c get is called the reduction is completed in the destructor.
+ * @tparam ContainerType the vector type of the scalar product
+ */
+template<class ContainerType>
+struct DotFuture
+{
+    using value_type = get_value_type<ContainerType>; //!< value type of the result
+    ///@cond
+    DotFuture( const ContainerType& x, std::vector<int64_t>& acc){
+        m_reduction.start( x, acc);
+        m_pending = true;
+    }
+    ///@endcond
+    DotFuture( const DotFuture&) = delete;
+    DotFuture& operator=( const DotFuture&) = delete;
+    ///@brief Take over the (pending) reduction of \c src
+    ///@param src source (becomes ready with an undefined result)
+    DotFuture( DotFuture&& src) noexcept: m_reduction( std::move( src.m_reduction)),
+        m_pending( src.m_pending), m_result( src.m_result)
+    {
+        src.m_pending = false;
+    }
+    ///@brief Complete the own reduction and take over the reduction of \c src
+    ///@param src source (becomes ready with an undefined result)
+    ///@return *this
+    DotFuture& operator=( DotFuture&& src){
+        if( this != &src)
+        {
+            wait();
+            m_reduction = std::move( src.m_reduction);
+            m_pending = src.m_pending, m_result = src.m_result;
+            src.m_pending = false;
+        }
+        return *this;
+    }
+    ~DotFuture(){ wait();}
+    /**
+     * @brief Wait for the reduction to complete and return the result
+     *
+     * May be called several times
+     * @return Scalar product, bitwise identical to the result of \c dg::blas1::dot
+     */
+    value_type get(){
+        wait();
+        return m_result;
+    }
+    private:
+    void wait(){
+        if( !m_pending) return;
+        std::vector<int64_t>& acc = m_reduction.wait();
+        m_result = exblas::cpu::Round( acc.data());
+        m_pending = false;
+    }
+    detail::SuperaccReduction<ContainerType> m_reduction;
+    bool m_pending = false;
+    value_type m_result = 0;
+};
+
+/*! @brief \f$ x^T y\f$ Binary reproducible Euclidean dot product with nonblocking reduction among processes
+ *
+ * Same as \c dg::blas1::dot except that with MPI the function returns before
+ * the global sum of the process-local results is complete
+For example
+@code
+auto energy = dg::blas1::dot_async( x, w);
+// ... do something useful, e.g. compute a derivative, change x
+double result = energy.get(); // same as dg::blas1::dot( x, w)
+@endcode
+ * @param x Left Container
+ * @param y Right Container may alias x
+ * @return A handle to the scalar product, call \c get to obtain the result
+ * @note The local part of the scalar product is computed synchronously; \c x
+ * and \c y can be changed or destroyed as soon as the function returns
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType1, class ContainerType2>
+inline DotFuture<find_if_t<dg::is_not_scalar, ContainerType1, ContainerType1, ContainerType2>> dot_async( const ContainerType1& x, const ContainerType2& y)
+{
+    using vector_type = find_if_t<dg::is_not_scalar, ContainerType1, ContainerType1, ContainerType2>;
+    constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar, ContainerType1, ContainerType1, ContainerType2>::value;
+    std::vector<int64_t> acc = dg::blas1::detail::doDot_superacc_local( x,y);
+    return DotFuture<vector_type>( get_idx<vector_idx>(x,y), acc);
+}
+
 /**
  * @brief \f$ f(x_0, x_1, ...)\f$; Customizable and generic blas1 function
  *
@@ -611,6 +820,54 @@ inline void subroutine( Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
     dg::blas1::detail::doSubroutine(tensor_category(), f, std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...);
 }
 
+///@cond
+namespace detail{
+template<class Tuple, class Subroutine, std::size_t ...I>
+inline void doFuse( Tuple& xs, Subroutine f, std::index_sequence<I...>)
+{
+    dg::blas1::subroutine( f, std::get<I>(xs)...);
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief \f$ f_0(x_0, x_1, ...); f_1(x_0,x_1,...); ...\f$ Several elementwise operations in one sweep
+ *
+ * Records a sequence of elementwise subroutines, each acting on a subset of the
+ * given vectors, and executes all of them in a single traversal through
+ * memory. Each operation is bound to its arguments with \c dg::on, where
+ * the indices refer to the position in \c xs.
+ * \f[ f_0(x_{0i}, x_{1i}, ...);\ f_1(x_{0i}, x_{1i}, ...);\ \dots \f]
+ * @copydoc hide_iterations
+ *
+@code
+//y = 2x + 3y; z = y/x + z; w = -w
+dg::blas1::fuse( std::tie( x, y, z, w),
+    dg::on<0,1>(   dg::Axpby<double>( 2., 3.)),
+    dg::on<1,0,2>( dg::PointwiseDivide<double>( 1., 1.)),
+    dg::on<3>(     dg::Scal<double>( -1.)));
+@endcode
+ * Since all operations are elementwise the result is exactly the same as
+ * executing them one after the other with separate \c blas1 calls
+ * (including aliasing of vectors), but every vector is read and written only once.
+ * These kernels are memory bound, so fusing \c k operations on the same
+ * vectors reduces the execution time by up to a factor \c k.
+ * @param xs all vectors and scalars that take part in the operations
+ * (use \c std::tie or \c std::forward_as_tuple to create the tuple)
+ * @param op the first operation
+ * @param ops more operations executed in the given order
+ * @tparam Operations subroutines taking an arbitrary number of arguments, usually generated by \c dg::on
+ * @note This is a convenience wrapper for <tt> dg::blas1::subroutine( dg::fuse( op, ops...), xs...) </tt>
+ * @copydoc hide_naninf
+ * @copydoc hide_ContainerType
+ */
+template< class ...ContainerTypes, class Operation, class ...Operations>
+inline void fuse( std::tuple<ContainerTypes...> xs, Operation op, Operations... ops)
+{
+    dg::blas1::detail::doFuse( xs, dg::fuse( op, ops...),
+            std::make_index_sequence<sizeof...(ContainerTypes)>());
+}
+
 ///@}
 }//namespace blas1
 
@@ -119,6 +119,11 @@ int main()
     dg::blas1::scal( w2, 0.6);
     dg::blas1::plus( w3, -7.0);
     std::cout << "e^2-7 = " << w3[0][0] <<" (0.389056...)"<< std::endl;
+    dg::blas1::fuse( std::tie( w1, w2, w3),
+        dg::on<0,1>( dg::Axpby<double>( 2., 3.)),
+        dg::on<1,0,2>( dg::PointwiseDivide<double>( 1., 0.)));
+    std::cout << "fuse 2*2+3*3 = " << w2[0][0] <<" (13)"<< std::endl;
+    std::cout << "fuse 13/2 = " << w3[0][0] <<" (6.5)"<< std::endl;
     std::cout << "\nFINISHED! Continue with topology/evaluation_t.cu !\n\n";
 
     return 0;
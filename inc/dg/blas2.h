@@ -50,6 +50,12 @@ inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const Matri
         "All container types must be either Scalar or have compatible Vector categories (AnyVector or Same base class)!");
     return doDot_superacc( x, m, y, get_tensor_category<MatrixType>(), vector_category());
 }
+template< class ContainerType1, class MatrixType, class ContainerType2>
+inline std::vector<int64_t> doDot_superacc_local( const ContainerType1& x, const MatrixType& m, const ContainerType2& y)
+{
+    using vector_type = find_if_t<dg::is_not_scalar, ContainerType1, ContainerType1, ContainerType2>;
+    return doDot_superacc_local( x, m, y, get_tensor_category<MatrixType>(), get_tensor_category<vector_type>());
+}
 
 }//namespace detail
 ///@endcond
@@ -173,6 +179,16 @@ inline void doSymv( MatrixType&& M,
             get_tensor_category<ContainerType1>());
 }
 
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void doSymv_batch( const std::vector<const MatrixType*>& M,
+                  const ContainerType1& x,
+                  const std::vector<ContainerType2*>& y,
+                  AnyMatrixTag)
+{
+    for( unsigned i=0; i<M.size(); i++)
+        dg::blas2::symv( *M[i], x, *y[i]);
+}
+
 }//namespace detail
 ///@endcond
 
@@ -225,6 +241,38 @@ inline void symv( MatrixType&& M,
 {
     dg::blas2::detail::doSymv( std::forward<MatrixType>(M), x, y, get_tensor_category<MatrixType>());
 }
+/*! @brief \f$ y_i = M_i x\f$ for several matrices applied to the same vector
+ *
+ * This routine computes \f[ y_i = M_i x \f] for all \c i.
+ * The result is the same as calling <tt> symv( *M[i], x, *y[i]) </tt> for
+ * every \c i, however for MPI matrices that need to communicate (e.g. the
+ * x- and y- derivatives) the halo exchanges of all matrices are started
+ * together and the inner points of all matrices are computed while the
+ * messages are in flight; the outer points are computed after all
+ * messages arrived. This hides more communication than separate calls,
+ * which each wait for their own messages after only one inner product.
+@code
+dg::x::DMatrix dx = dg::create::dx( grid), dy = dg::create::dy( grid);
+dg::x::DVec f = dg::evaluate( dg::one, grid), dxf(f), dyf(f);
+dg::blas2::symv_batch( std::vector<const dg::x::DMatrix*>{&dx, &dy}, f,
+    std::vector<dg::x::DVec*>{&dxf, &dyf});
+@endcode
+ * @param M The Matrices (must all have the same communicator)
+ * @param x input vector
+ * @param y contains the solutions on output (may not alias \p x and \c y.size() must equal \c M.size())
+ * @copydoc hide_matrix
+ * @copydoc hide_ContainerType
+ */
+template< class MatrixType, class ContainerType1, class ContainerType2>
+inline void symv_batch( const std::vector<const MatrixType*>& M,
+                  const ContainerType1& x,
+                  const std::vector<ContainerType2*>& y)
+{
+#ifdef DG_DEBUG
+    assert( M.size() == y.size());
+#endif //DG_DEBUG
+    dg::blas2::detail::doSymv_batch( M, x, y, get_tensor_category<MatrixType>());
+}
 /*! @brief \f$ y = \alpha M x + \beta y \f$;
  * (alias for symv)
  *
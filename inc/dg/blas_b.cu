@@ -220,6 +220,52 @@ int main()
         norm += dg::blas2::dot( x, w2d, y);
     t.toc();
     std::cout<<"DOT2(x,w,y) took                 " <<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n"; //DOT should be faster than axpby since it is only loading vectors and not writing them
+    value_type exact = dg::blas2::dot( x, w2d, y);
+    dg::set_reduction_policy( dg::ReductionPolicy::fast);
+    norm += dg::blas1::dot( x,y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        norm += dg::blas1::dot( x,y);
+    t.toc();
+    std::cout<<"DOT1(x,y) (fast) took            " <<t.diff()/multi<<"s\t"<<2*gbytes*multi/t.diff()<<"GB/s\n";
+    norm += dg::blas2::dot( x, w2d, y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        norm += dg::blas2::dot( x, w2d, y);
+    t.toc();
+    std::cout<<"DOT2(x,w,y) (fast) took          " <<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    value_type fast = dg::blas2::dot( x, w2d, y);
+    dg::set_reduction_policy( dg::ReductionPolicy::reproducible);
+    std::cout<<"Relative difference fast - reproducible "<<(fast-exact)/exact<<"\n";
+
+    std::cout << "\nMany small kernels (64x64 2d grid)\n";
+    dg::RealGrid2d<value_type> grid_small( 0., lx, 0, ly, n, 64, 64);
+    Matrix dx_small = dg::create::dx( grid_small, dg::centered);
+    Vector a = dg::construct<Vector>( dg::evaluate( dg::one, grid_small)), b(a);
+    int multi_small = 1000;
+    t.tic();
+    for( int i=0; i<multi_small; i++)
+    {
+        dg::blas2::symv( dx_small, a, b);
+        dg::blas1::axpby( 1e-3, b, 1., a);
+        norm += dg::blas1::dot( a, b);
+    }
+    t.toc();
+    std::cout<<"symv, axpby and dot took         " <<t.diff()/multi_small<<"s\n";
+    t.tic();
+    dg::parallel_session( [&](){
+        value_type session_norm = 0;
+        for( int i=0; i<multi_small; i++)
+        {
+            dg::blas2::symv( dx_small, a, b);
+            dg::blas1::axpby( 1e-3, b, 1., a);
+            session_norm += dg::blas1::dot( a, b);
+        }
+        #pragma omp master
+        norm += session_norm;
+    });
+    t.toc();
+    std::cout<<"         in a parallel session   " <<t.diff()/multi_small<<"s\n";
 
     std::cout << "\nSequential recursive calls";
     unsigned size_rec = 1e4;
@@ -171,6 +171,44 @@ int main( int argc, char* argv[])
         dg::blas2::symv( M, x, y);
     t.toc();
     if(rank==0)std::cout<<"centered y derivative took       "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    dg::set_halo_exchange_policy( dg::HaloExchangePolicy::persistent);
+    dg::blas2::symv( M, x, y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( M, x, y);
+    t.toc();
+    if(rank==0)std::cout<<"centered y (persistent requests) "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    dg::set_halo_exchange_policy( dg::HaloExchangePolicy::neighbor_alltoallw);
+    dg::blas2::symv( M, x, y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( M, x, y);
+    t.toc();
+    if(rank==0)std::cout<<"centered y (neighbor alltoallw)  "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    dg::set_halo_exchange_policy( dg::HaloExchangePolicy::shared_window);
+    dg::blas2::transfer(dg::create::dy( grid, dg::centered), M); //creates the window
+    dg::blas2::symv( M, x, y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( M, x, y);
+    t.toc();
+    if(rank==0)std::cout<<"centered y (shared window)       "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    dg::set_halo_exchange_policy( dg::HaloExchangePolicy::isend_irecv);
+    dg::set_halo_packing_policy( dg::HaloPackingPolicy::derived_datatype);
+    dg::blas2::symv( M, x, y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( M, x, y);
+    t.toc();
+    if(rank==0)std::cout<<"centered y (derived datatypes)   "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    dg::blas2::transfer(dg::create::dx( grid, dg::centered), M);
+    dg::blas2::symv( M, x, y);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( M, x, y);
+    t.toc();
+    if(rank==0)std::cout<<"centered x (derived datatypes)   "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    dg::set_halo_packing_policy( dg::HaloPackingPolicy::pack);
 
     if( grid.Nz() > 1)
     {
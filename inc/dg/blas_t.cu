@@ -64,6 +64,33 @@ int main()
     std::array<std::vector<dg::DVec>,1> recursive{ arrdvec1};
     dg::blas2::symv( arrdvec1[0], recursive, recursive);
     std::cout << "symv deep Recursion               "<<( recursive[0][0][0] == 52*52) << std::endl;
+    std::cout << "Test parallel session:\n";
+    dg::DVec xs( 1000, 0.1), ys( 1000, 0.2);
+    dg::blas1::axpby( 1., xs, 2., ys);
+    double reference = dg::blas1::dot( xs, ys);
+    dg::blas1::copy( 0.2, ys);
+    bool failed = false;
+    dg::parallel_session( [&](){
+        dg::blas1::axpby( 1., xs, 2., ys);
+        double norm = dg::blas1::dot( xs, ys);//all threads compute the same
+        if( norm != reference)
+        {
+            #pragma omp atomic write
+            failed = true;
+        }
+    });
+    std::cout << "session dot                       "<<( !failed) << std::endl;
+    dg::blas1::copy( NAN, ys);
+    try{
+        dg::parallel_session( [&](){
+            double norm = dg::blas1::dot( xs, ys);//throws on all threads
+            dg::blas1::scal( ys, norm);
+        });
+        std::cout << "session NaN dot throws            0"<< std::endl;
+    }catch( dg::Error& e)
+    {
+        std::cout << "session NaN dot throws            1"<< std::endl;
+    }
 
     return 0;
 }
@@ -5,6 +5,8 @@
 
 #include "blas.h"
 #include "functors.h"
+#include "backend/memory.h"
+#include "backend/binary_io.h"
 
 #ifdef DG_BENCHMARK
 #include "backend/timer.h"
@@ -52,17 +54,36 @@ class CG
     unsigned get_max() const {return max_iter;}
     ///@brief Return an object of same size as the object used for construction
     ///@return A copyable object; what it contains is undefined, its size is important
-    const ContainerType& copyable()const{ return r;}
+    ///@note Returns a copy since with a workspace the object holds no container
+    ContainerType copyable()const{ return m_ws ? m_ws->copyable() : r;}
 
     /**
      * @brief Allocate memory for the pcg method
      *
      * @param copyable A ContainerType must be copy-constructible from this
      * @param max_iterations Maximum number of iterations to be used
+     * @note Removes a workspace set with \c set_workspace
      */
     void construct( const ContainerType& copyable, unsigned max_iterations) {
         ap = p = r = copyable;
         max_iter = max_iterations;
+        m_ws = nullptr;
+    }
+    /**
+     * @brief Borrow the three temporaries from a shared workspace
+     *
+     * The memory held by this object is freed and every solve borrows its
+     * temporaries from \c ws instead, such that other objects can use the same
+     * memory between solves
+     * @param ws containers in \c ws must have the size of \c copyable(); if \c nullptr
+     * the temporaries are allocated and owned by this object again
+     */
+    void set_workspace( std::shared_ptr<Workspace<ContainerType>> ws){
+        if( !ws && m_ws)
+            ap = p = r = m_ws->copyable();
+        m_ws = ws;
+        if( m_ws)
+            ap = p = r = ContainerType();
     }
     /**
      * @brief Solve the system A*x = b using a preconditioned conjugate gradient method
@@ -117,6 +138,7 @@ class CG
   private:
     ContainerType r, p, ap;
     unsigned max_iter;
+    std::shared_ptr<Workspace<ContainerType>> m_ws;
 };
 
 /*
@@ -157,6 +179,10 @@ unsigned CG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const Con
         blas1::axpby( 1., b, 0., x);
         return 0;
     }
+    //r, p and ap hold memory of the workspace until we return
+    std::vector<typename Workspace<ContainerType>::Temporary> borrowed;
+    if( m_ws)
+        borrowed = m_ws->borrow( {&r, &p, &ap});
     blas2::symv( A,x,r);
     blas1::axpby( 1., b, -1., r);
     blas2::symv( P, r, p );//<-- compute p_0
@@ -220,6 +246,10 @@ unsigned CG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const Con
         blas1::copy( b, x);
         return 0;
     }
+    //r, p and ap hold memory of the workspace until we return
+    std::vector<typename Workspace<ContainerType>::Temporary> borrowed;
+    if( m_ws)
+        borrowed = m_ws->borrow( {&r, &p, &ap});
     blas2::symv( A,x,r);
     blas1::axpby( 1., b, -1., r);
     //note that dot does automatically synchronize
@@ -258,6 +288,206 @@ unsigned CG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const Con
 }
 ///@endcond
 
+///@cond
+namespace detail{
+//all vector updates of one pipelined CG iteration in one sweep
+template<class T>
+struct PipelinedCGUpdate
+{
+    PipelinedCGUpdate( T alpha, T beta): m_alpha(alpha), m_beta(beta){}
+    template<class T0>
+DG_DEVICE
+    void operator()( T n, T m, T& z, T& q, T& s, T& p, T0& x, T& r, T& u, T& w)const{
+        z = DG_FMA( m_beta, z, n);
+        q = DG_FMA( m_beta, q, m);
+        s = DG_FMA( m_beta, s, w);
+        p = DG_FMA( m_beta, p, u);
+        x = DG_FMA( m_alpha, p, x);
+        r = DG_FMA( -m_alpha, s, r);
+        u = DG_FMA( -m_alpha, q, u);
+        w = DG_FMA( -m_alpha, z, w);
+    }
+    private:
+    T m_alpha, m_beta;
+};
+}//namespace detail
+///@endcond
+
+/**
+* @brief Pipelined preconditioned conjugate gradient method to solve
+* \f[ M^{-1}Ax=M^{-1}b\f]
+*
+* Mathematically equivalent to \c dg::CG but all scalar products of one
+* iteration (\f$ r^T P r\f$, \f$ w^TPr\f$ and the residual norm \f$ r^TSr\f$)
+* are reduced together in a single (superaccumulator) exchange.
+* With MPI this exchange is a nonblocking collective that overlaps with the
+* application of the preconditioner and the matrix in the same iteration.
+* This pays off when the iterations are latency bound on global reductions,
+* i.e. on many processes with small local problems. The price are 6 more
+* vectors and a few more vector updates (all done in a single sweep through memory)
+* and a slightly larger sensitivity to rounding errors.
+*
+* @ingroup invert
+*
+* @sa This implements the pipelined PCG algorithm as given in
+* P. Ghysels, W. Vanroose "Hiding global synchronization latency in the preconditioned Conjugate Gradient algorithm" Parallel Computing 40 (2014)
+* @attention beware the sign: a negative definite matrix does @b not work in Conjugate gradient
+* @note The result is binary reproducible but differs from the one of \c dg::CG in the last digits
+* @copydoc hide_ContainerType
+*/
+template< class ContainerType>
+class PipelinedCG
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    PipelinedCG(){}
+    ///@copydoc construct()
+    PipelinedCG( const ContainerType& copyable, unsigned max_iterations){
+        construct( copyable, max_iterations);
+    }
+    ///@brief Set the maximum number of iterations
+    ///@param new_max New maximum number
+    void set_max( unsigned new_max) {m_max_iter = new_max;}
+    ///@brief Get the current maximum number of iterations
+    ///@return the current maximum
+    unsigned get_max() const {return m_max_iter;}
+    ///@brief Return an object of same size as the object used for construction
+    ///@return A copyable object; what it contains is undefined, its size is important
+    ///@note Returns a copy since with a workspace the object holds no container
+    ContainerType copyable()const{ return m_ws ? m_ws->copyable() : m_r;}
+
+    /**
+     * @brief Allocate memory for the pipelined pcg method
+     *
+     * @param copyable A ContainerType must be copy-constructible from this
+     * @param max_iterations Maximum number of iterations to be used
+     * @note Removes a workspace set with \c set_workspace
+     */
+    void construct( const ContainerType& copyable, unsigned max_iterations) {
+        m_r = m_u = m_w = m_m = m_n = m_z = m_q = m_s = m_p = copyable;
+        m_max_iter = max_iterations;
+        m_ws = nullptr;
+    }
+    ///@copydoc CG::set_workspace()
+    void set_workspace( std::shared_ptr<Workspace<ContainerType>> ws){
+        if( !ws && m_ws)
+            m_r = m_u = m_w = m_m = m_n = m_z = m_q = m_s = m_p = m_ws->copyable();
+        m_ws = ws;
+        if( m_ws)
+            m_r = m_u = m_w = m_m = m_n = m_z = m_q = m_s = m_p = ContainerType();
+    }
+    /**
+     * @brief Solve \f$ Ax = b\f$ using a pipelined preconditioned conjugate gradient method
+     *
+     * The iteration stops if \f$ ||b - Ax||_S < \epsilon( ||b||_S + C) \f$ where \f$C\f$ is
+     * the absolute error in units of \f$ \epsilon\f$ and \f$ S \f$ defines a square norm
+     * @param A A symmetric positive definit matrix
+     * @param x Contains an initial value on input and the solution on output.
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     *
+     * @return Number of iterations used to achieve desired precision
+     * @note Required memops per iteration (\c P and \c S are assumed vectors):
+             - 18  reads + 9 writes
+             - plus the number of memops for \c A;
+             - one global reduction (of three superaccumulators)
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     * @tparam SquareNorm A type for which the blas2::dot( const SquareNorm&, const ContainerType&) function is callable. This can e.g. be one of the ContainerType types.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned operator()( MatrixType& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps = 1e-12, value_type nrmb_correction = 1);
+  private:
+    ContainerType m_r, m_u, m_w, m_m, m_n, m_z, m_q, m_s, m_p;
+    unsigned m_max_iter;
+    std::shared_ptr<Workspace<ContainerType>> m_ws;
+    blas1::detail::SuperaccReduction<ContainerType> m_reduction;
+};
+
+///@cond
+template< class ContainerType>
+template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
+unsigned PipelinedCG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction)
+{
+    value_type nrmb = sqrt( blas2::dot( S, b));
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if(rank==0)
+#endif //MPI
+    {
+    std::cout << "# Norm of S b "<<nrmb <<"\n";
+    std::cout << "# Residual errors: \n";
+    }
+#endif //DG_DEBUG
+    if( nrmb == 0)
+    {
+        blas1::copy( b, x);
+        return 0;
+    }
+    std::vector<typename Workspace<ContainerType>::Temporary> borrowed;
+    if( m_ws)
+        borrowed = m_ws->borrow( {&m_r, &m_u, &m_w, &m_m, &m_n, &m_z, &m_q, &m_s, &m_p});
+    blas2::symv( A,x,m_r);
+    blas1::axpby( 1., b, -1., m_r);
+    blas2::symv( P, m_r, m_u);
+    blas2::symv( A, m_u, m_w);
+    blas1::copy( 0., m_z);
+    blas1::copy( 0., m_q);
+    blas1::copy( 0., m_s);
+    blas1::copy( 0., m_p);
+    value_type alpha = 0, gamma_old = 0;
+    for( unsigned i=0; i<m_max_iter; i++)
+    {
+        // start the reduction of gamma = r P r, delta = w P r and r S r ...
+        std::vector<int64_t> acc = blas1::detail::doDot_superacc_local( m_r, m_u);
+        std::vector<int64_t> acc_w = blas1::detail::doDot_superacc_local( m_w, m_u);
+        std::vector<int64_t> acc_r = blas2::detail::doDot_superacc_local( m_r, S, m_r);
+        acc.insert( acc.end(), acc_w.begin(), acc_w.end());
+        acc.insert( acc.end(), acc_r.begin(), acc_r.end());
+        m_reduction.start( m_r, acc);
+        // ... overlap with preconditioner and matrix application
+        blas2::symv( P, m_w, m_m);
+        blas2::symv( A, m_m, m_n);
+        std::vector<int64_t>& red = m_reduction.wait();
+        value_type gamma = exblas::cpu::Round( &red[0]);
+        value_type delta = exblas::cpu::Round( &red[exblas::BIN_COUNT]);
+        value_type nrm2r = exblas::cpu::Round( &red[2*exblas::BIN_COUNT]);
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+        if(rank==0)
+#endif //MPI
+        {
+            std::cout << "# Absolute r*S*r "<<sqrt( nrm2r) <<"\t ";
+            std::cout << "#  < Critical "<<eps*nrmb + eps <<"\t ";
+            std::cout << "# (Relative "<<sqrt( nrm2r)/nrmb << ")\n";
+        }
+#endif //DG_DEBUG
+        if( sqrt( nrm2r) < eps*(nrmb + nrmb_correction))
+            return i;
+        value_type beta = 0;
+        if( i == 0)
+            alpha = gamma/delta;
+        else
+        {
+            beta = gamma/gamma_old;
+            alpha = gamma/(delta - beta*gamma/alpha);
+        }
+        gamma_old = gamma;
+        blas1::subroutine( detail::PipelinedCGUpdate<value_type>( alpha, beta),
+            m_n, m_m, m_z, m_q, m_s, m_p, x, m_r, m_u, m_w);
+    }
+    return m_max_iter;
+}
+///@endcond
+
 /**
 * @brief Extrapolate a polynomial passing through up to three points
 *
@@ -287,7 +517,7 @@ struct Extrapolation
     using container_type = ContainerType;
     /*! @brief Leave values uninitialized
      */
-    Extrapolation( ){ m_counter = 0; }
+    Extrapolation( ){ m_counter = m_max = 0; }
     /*! @brief Set maximum extrapolation order and allocate memory
      * @param max maximum of vectors to use for extrapolation.
          Choose between 0 (no extrapolation) 1 (constant), 2 (linear) or 3 (parabola) extrapolation.
@@ -455,6 +685,36 @@ struct Extrapolation
         return m_x[m_max-1];
     }
 
+    /**
+     * @brief Write all stored entries and times to a binary stream
+     *
+     * Together with \c load this allows to restart a simulation with exactly
+     * the same initial guesses as the uninterrupted run
+     * @param os output stream (opened with \c std::ios::binary)
+     * @sa dg::write_binary
+     */
+    void save( std::ostream& os) const{
+        dg::write_binary( os, m_max);
+        dg::write_binary( os, m_counter);
+        dg::write_binary( os, m_t);
+        dg::write_binary( os, m_x);
+    }
+    /**
+     * @brief Read the state written by \c save
+     *
+     * @param is input stream (opened with \c std::ios::binary)
+     * @throw dg::Error if the stored maximum or sizes do not match this object
+     */
+    void load( std::istream& is){
+        unsigned max;
+        dg::read_binary( is, max);
+        if( max != m_max)
+            throw dg::Error( dg::Message(_ping_)<<"Stored extrapolation max "<<max<<" does not match "<<m_max<<"!");
+        dg::read_binary( is, m_counter);
+        dg::read_binary( is, m_t);
+        dg::read_binary( is, m_x);
+    }
+
     private:
     unsigned m_max, m_counter;
     std::vector<value_type> m_t;
@@ -500,7 +760,7 @@ struct Invert
     }
     ///@brief Return an object of same size as the object used for construction
     ///@return A copyable object; what it contains is undefined, its size is important
-    const ContainerType& copyable()const{ return cg.copyable();}
+    ContainerType copyable()const{ return cg.copyable();}
 
     /**
      * @brief Allocate memory
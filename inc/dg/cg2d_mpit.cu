@@ -66,6 +66,23 @@ int main( int argc, char* argv[])
     if(rank==0)std::cout << "L2 Norm of Residuum is        " << res.d<<"\t"<<res.i << std::endl;
     //Fehler der Integration des Sinus ist vernachlässigbar (vgl. evaluation_t)
 
+    if( rank == 0) std::cout << "Pipelined CG\n";
+    dg::blas1::copy( 0., x);
+    dg::PipelinedCG< dg::MDVec > ppcg( x, n*n*Nx*Ny);
+    number = ppcg( A, x, b, A.precond(), A.inv_weights(), eps);
+    if( rank == 0)
+    {
+        std::cout << "# of pipelined pcg itersations   "<<number<<std::endl;
+        std::cout << "... for a precision of "<< eps<<std::endl;
+    }
+    dg::blas1::axpby( 1., x,-1., solution, error);
+    dg::blas2::symv(  A, x, Ax);
+    dg::blas1::axpby( 1., b, -1., Ax, resi);
+    res.d = sqrt(dg::blas2::dot(w2d , error));
+    if(rank==0)std::cout << "L2 Norm of Error is           " << res.d<<"\t"<<res.i << std::endl;
+    res.d = sqrt(dg::blas2::dot( w2d, resi));
+    if(rank==0)std::cout << "L2 Norm of Residuum is        " << res.d<<"\t"<<res.i << std::endl;
+
     MPI_Finalize();
     return 0;
 }
@@ -69,6 +69,13 @@ void solve( std::string solver, Matrix& A, Container& x, const Container& b, con
         unsigned num_iter = bicg.solve( A, x, b, A.precond(), A.inv_weights(), 1e-6);
         std::cout << "After "<<num_iter<<" BICGSTABl iterations we have:\n";
     }
+    if( "pipelined cg" == solver)
+    {
+        std::cout <<" PIPELINED CG SOLVER:\n";
+        dg::PipelinedCG<Container> pcg( x, n*n*Nx*Ny);
+        unsigned num_iter = pcg( A, x, b, A.precond(), A.inv_weights(), 1e-6);
+        std::cout << "After "<<num_iter<<" pipelined CG iterations we have:\n";
+    }
     if( "lgmres" == solver)
     {
         std::cout <<" LGMRES SOLVER:\n";
@@ -137,7 +144,7 @@ int main()
     std::cout << "L2 Norm of Residuum is        " << res.d<<"\t"<<res.i << std::endl<<std::endl;
     //Fehler der Integration des Sinus ist vernachlässigbar (vgl. evaluation_t)
 
-    std::vector<std::string> solvers{ "eve cg", "eve pcg", "cheby", "P cheby", "bicgstabl", "lgmres"};
+    std::vector<std::string> solvers{ "eve cg", "eve pcg", "cheby", "P cheby", "bicgstabl", "pipelined cg", "lgmres"};
     for(auto solver : solvers)
     {
         dg::blas1::copy( 0., x);
@@ -158,6 +165,25 @@ int main()
         res.d = sqrt(dg::blas2::dot( w2d, resi));
         std::cout << "L2 Norm of Residuum is        " << res.d<<"\n\n";
     }
+    std::cout << " PCG SOLVER WITH THE FUSED ELLIPTIC KERNEL INSIDE A PARALLEL SESSION:\n";
+    {
+        dg::Elliptic<dg::CartesianGrid2d, dg::DMatrix, dg::DVec> DA( grid);
+        const dg::DVec db( b), dv2d( v2d);
+        dg::DVec x_ref = dg::evaluate( initial, grid), x_session( x_ref);
+        dg::CG<dg::DVec> dpcg( x_ref, max_iter);
+        unsigned num_ref = dpcg( DA, x_ref, db, dv2d, eps);
+        unsigned num_session = 0;
+        //all containers are shared, every thread executes the same solve
+        dg::parallel_session( [&](){
+            unsigned num = dpcg( DA, x_session, db, dv2d, eps);
+            #pragma omp master
+            num_session = num;
+        });
+        dg::blas1::axpby( 1., x_ref, -1., x_session);
+        res.d = sqrt( dg::blas1::dot( x_session, x_session));
+        std::cout << "Number of pcg iterations "<<num_ref<<" in session "<<num_session<<" (should be equal)\n";
+        std::cout << "Difference to solve outside session "<<res.d<<"\t"<<res.i<<" (should be 0)\n\n";
+    }
     // Test Extrapolation object
     double value;
     dg::Extrapolation<double> extra(3,-1);
@@ -10,6 +10,9 @@
 #include "topology/mpi_evaluation.h"
 #endif
 #include "topology/geometry.h"
+#ifdef _OPENMP
+#include "backend/elliptic_omp_kernels.h"
+#endif
 
 /*! @file
 
@@ -233,6 +236,23 @@ class Elliptic
      * @return Whether the weighting of jump terms with chi is enabled. Either true or false.
      */
     bool get_jump_weighting() const {return m_chi_weight_jump;}
+    /**
+     * @brief Switch the matrix-free fused kernel on or off
+     *
+     * With \c Container a \c dg::DVec and \c Matrix a \c dg::DMatrix
+     * in an OpenMP build, \c symv by default applies gradient, tensor
+     * multiplication, divergence and jump terms cell by cell in a single
+     * kernel without full size temporaries. The result is binary identical
+     * to the unfused version, which is used for all other types, for
+     * aliased input and output, and if the jump terms are weighted with chi.
+     * @param fused If false, always use the unfused implementation
+     */
+    void set_fused_kernel( bool fused) {m_fused = fused;}
+    /**
+     * @brief Get the current state of the fused kernel switch
+     * @return Whether the fused kernel is used if possible. Either true or false.
+     */
+    bool get_fused_kernel() const {return m_fused;}
     /**
      * @brief Compute elliptic term and store in output
      *
@@ -271,6 +291,13 @@ class Elliptic
     template<class ContainerType0, class ContainerType1>
     void symv( value_type alpha, const ContainerType0& x, value_type beta, ContainerType1& y)
     {
+        using fusable = std::integral_constant<bool,
+            std::is_same<Matrix, EllSparseBlockMatDevice<value_type>>::value &&
+            std::is_same<ContainerType0, Container>::value &&
+            std::is_same<ContainerType1, Container>::value &&
+            std::is_same<get_execution_policy<Container>, OmpTag>::value>;
+        if( fused_symv( alpha, x, beta, y, fusable()))
+            return;
         //compute gradient
         dg::blas2::gemv( m_rightx, x, m_tempx); //R_x*f
         dg::blas2::gemv( m_righty, x, m_tempy); //R_y*f
@@ -355,6 +382,61 @@ class Elliptic
         m_no = new_norm;
     }
     private:
+    template<class ContainerType0, class ContainerType1>
+    bool fused_symv( value_type alpha, const ContainerType0& x, value_type beta, ContainerType1& y, std::false_type)
+    {
+        return false;
+    }
+    template<class ContainerType0, class ContainerType1>
+    bool fused_symv( value_type alpha, const ContainerType0& x, value_type beta, ContainerType1& y, std::true_type)
+    {
+#ifdef _OPENMP
+        if( !m_fused || m_chi_weight_jump || (const void*)&x == (const void*)&y)
+            return false;
+        if( !detail::fused_elliptic2d_applicable( m_rightx, m_righty, m_leftx,
+                    m_lefty, m_jumpX, m_jumpY))
+            return false;
+        const value_type* x_ptr = thrust::raw_pointer_cast( x.data());
+        value_type* y_ptr = thrust::raw_pointer_cast( y.data());
+        const value_type* w_ptr = thrust::raw_pointer_cast(
+                m_no == normed ? m_vol.data() : m_weights_wo_vol.data());
+        const value_type* s_ptr = thrust::raw_pointer_cast( m_sigma.data());
+        const value_type* t00 = thrust::raw_pointer_cast( m_chi.value(0,0).data());
+        const value_type* t01 = thrust::raw_pointer_cast( m_chi.value(0,1).data());
+        const value_type* t10 = thrust::raw_pointer_cast( m_chi.value(1,0).data());
+        const value_type* t11 = thrust::raw_pointer_cast( m_chi.value(1,1).data());
+        const int slots = m_lefty.blocks_per_line+1, n = m_righty.n;
+        const int M = m_rightx.num_rows*n;
+        if( !omp_in_parallel())
+        {
+            if( !m_fused_ws.fits( omp_get_max_threads(), slots, n, M))
+                m_fused_ws.resize( omp_get_max_threads(), slots, n, M);
+            #pragma omp parallel
+            {
+                detail::launch_fused_elliptic2d_kernel( alpha, beta, m_rightx,
+                    m_righty, m_leftx, m_lefty, m_jumpX, m_jumpY, m_jfactor,
+                    s_ptr, t00, t01, t10, t11, w_ptr, m_no == normed, x_ptr,
+                    y_ptr, m_fused_ws);
+            }
+            return true;
+        }
+        //all threads of the session take the same decision
+        if( !m_fused_ws.fits( omp_get_num_threads(), slots, n, M))
+        {
+            #pragma omp barrier
+            #pragma omp single
+            m_fused_ws.resize( omp_get_num_threads(), slots, n, M);
+        }
+        detail::launch_fused_elliptic2d_kernel( alpha, beta, m_rightx,
+            m_righty, m_leftx, m_lefty, m_jumpX, m_jumpY, m_jfactor,
+            s_ptr, t00, t01, t10, t11, w_ptr, m_no == normed, x_ptr, y_ptr,
+            m_fused_ws);
+        dg::detail::parallel_session_barrier();
+        return true;
+#else
+        return false;
+#endif //_OPENMP
+    }
     Matrix m_leftx, m_lefty, m_rightx, m_righty, m_jumpX, m_jumpY;
     Container m_weights, m_inv_weights, m_precond, m_weights_wo_vol;
     Container m_tempx, m_tempy, m_temp;
@@ -363,6 +445,10 @@ class Elliptic
     Container m_sigma, m_vol;
     value_type m_jfactor;
     bool m_chi_weight_jump;
+    bool m_fused = true;
+#ifdef _OPENMP
+    detail::FusedEllipticWorkspace<value_type> m_fused_ws;
+#endif //_OPENMP
 };
 
 ///@copydoc Elliptic
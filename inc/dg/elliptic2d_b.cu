@@ -128,6 +128,45 @@ int main()
 
     }
 
+    {
+    std::cout << "Centered Elliptic Multigrid mixed precision\n";
+    const unsigned stages = 3;
+    //! [mixed]
+    dg::MultigridCG2d<dg::aGeometry2d, dg::DMatrix, dg::DVec > multigrid( grid, stages);
+    const dg::RealCartesianGrid2d<float> fgrid( 0, lx, 0, ly, n, Nx, Ny, bcx, bcy);
+    dg::MultigridCG2d<dg::aRealGeometry2d<float>, dg::fDMatrix, dg::fDVec > fmultigrid( fgrid, stages);
+    const std::vector<dg::DVec> multi_chi = multigrid.project( chi);
+    dg::fDVec fchi;
+    dg::assign( chi, fchi);
+    const std::vector<dg::fDVec> fmulti_chi = fmultigrid.project( fchi);
+    std::vector<dg::Elliptic<dg::aGeometry2d, dg::DMatrix, dg::DVec> > multi_pol( stages);
+    std::vector<dg::Elliptic<dg::aRealGeometry2d<float>, dg::fDMatrix, dg::fDVec> > fmulti_pol( stages);
+    for(unsigned u=0; u<stages; u++)
+    {
+        multi_pol[u].construct( multigrid.grid(u), dg::not_normed, dg::centered, jfactor);
+        multi_pol[u].set_chi( multi_chi[u]);
+        fmulti_pol[u].construct( fmultigrid.grid(u), dg::not_normed, dg::centered, jfactor);
+        fmulti_pol[u].set_chi( fmulti_chi[u]);
+    }
+    for( unsigned float_fine_cg = 0; float_fine_cg < 2; float_fine_cg++)
+    {
+        x = temp;
+        dg::Timer t;
+        t.tic();
+        std::vector<unsigned> number = multigrid.mixed_precision_solve(
+            multi_pol, fmultigrid, fmulti_pol, x, b, eps, float_fine_cg);
+        t.toc();
+        //! [mixed]
+        std::cout << "Float fine CG "<<float_fine_cg<<" Solution took "<< t.diff() <<"s\n";
+        for( unsigned u=0; u<number.size(); u++)
+            std::cout << " # iterations stage "<< number.size()-1-u << " " << number[number.size()-1-u] << " \n";
+        dg::blas1::axpby( 1.,x,-1., solution, error);
+        double err = dg::blas2::dot( w2d, error);
+        err = sqrt( err/norm); res.d = err;
+        std::cout << " "<<err << "\t"<<res.i<<"\n";
+    }
+    }
+
     {
     std::cout << "Forward Elliptic\n";
     x = temp;
@@ -191,8 +230,28 @@ int main()
         err = sqrt( err/norm); res.d = err;
         std::cout << " "<<err << "\t"<<res.i<<std::endl;
     }
-
-
+    {
+        std::cout << "Fused and unfused Elliptic operator\n";
+        dg::Elliptic<dg::CartesianGrid2d, dg::DMatrix, dg::DVec> pol( grid, dg::not_normed, dg::centered, jfactor);
+        pol.set_chi( chi);
+        dg::DVec y_fused( x), y_unfused( x);
+        dg::Timer t;
+        const unsigned multi = 100;
+        pol.set_fused_kernel( false);
+        t.tic();
+        for( unsigned i=0; i<multi; i++)
+            dg::blas2::symv( pol, solution, y_unfused);
+        t.toc();
+        std::cout << " Unfused symv took "<<t.diff()/multi<<"s\n";
+        pol.set_fused_kernel( true);
+        t.tic();
+        for( unsigned i=0; i<multi; i++)
+            dg::blas2::symv( pol, solution, y_fused);
+        t.toc();
+        std::cout << " Fused symv took   "<<t.diff()/multi<<"s\n";
+        dg::blas1::axpby( 1., y_fused, -1., y_unfused);
+        std::cout << " Difference (must be exactly 0) "<<dg::blas1::dot( y_unfused, y_unfused)<<std::endl;
+    }
 
     return 0;
 }
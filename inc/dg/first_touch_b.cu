@@ -0,0 +1,64 @@
+#include <iostream>
+#include <iomanip>
+
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+
+#include "backend/timer.h"
+#include "blas.h"
+#include "topology/derivatives.h"
+#include "topology/evaluation.h"
+
+const double lx = 2.*M_PI;
+const double ly = 2.*M_PI;
+double left( double x, double y, double z) {return sin(x)*cos(y)*z;}
+double right( double x, double y, double z) {return cos(x)*sin(y)*z;}
+
+template<class Vector>
+void benchmark( const dg::Grid3d& grid, std::string name)
+{
+    dg::Timer t;
+    int multi=100;
+    //the vectors are evaluated serially on the host and then copied
+    Vector x = dg::construct<Vector>( dg::evaluate( left, grid));
+    Vector y = dg::construct<Vector>( dg::evaluate( right, grid)), z(y);
+    dg::DMatrix dx = dg::create::dx( grid, dg::centered);
+    double gbytes=(double)x.size()*sizeof(double)/1e9;
+    std::cout << "\n"<<name<<"\n";
+    dg::blas1::axpby( 1., y, -1., x);//warm up
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::axpby( 1., y, -1., x);
+    t.toc();
+    std::cout<<"AXPBY (1*y-1*x=x)                "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas1::pointwiseDot( 1., y, x, 2., z);
+    t.toc();
+    std::cout<<"pointwiseDot (yx+2z=z)           "<<t.diff()/multi<<"s\t"<<4*gbytes*multi/t.diff()<<"GB/s\n";
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( dx, x, y);
+    t.toc();
+    std::cout<<"SYMV (x derivative!)             "<<t.diff()/multi<<"s\t"<<3*gbytes*multi/t.diff()<<"GB/s\n";
+    double norm = 0;
+    t.tic();
+    for( int i=0; i<multi; i++)
+        norm += dg::blas1::dot( x, y);
+    t.toc();
+    std::cout<<"DOT1(x,y)                        "<<t.diff()/multi<<"s\t"<<2*gbytes*multi/t.diff()<<"GB/s\n";
+}
+
+int main()
+{
+    unsigned n, Nx, Ny, Nz;
+    std::cout << "This program compares the memory bandwidth of vectors allocated with the default allocator and with the NUMA-aware dg::FirstTouchAllocator. ";
+    std::cout << "On multi-socket nodes run with pinned threads (e.g. OMP_PROC_BIND=true OMP_PLACES=cores) on all sockets, on single-socket nodes both should perform the same\n";
+    std::cout << "Type n (3), Nx (512) , Ny (512) and Nz (10) \n";
+    std::cin >> n >> Nx >> Ny >> Nz;
+    dg::Grid3d grid( 0., lx, 0, ly, 0, ly, n, Nx, Ny, Nz);
+    std::cout << "Size of vectors is "<<(double)grid.size()*sizeof(double)/1e9<<" GB\n";
+    benchmark<dg::DVec>( grid, "Default allocator (dg::DVec)");
+    benchmark<dg::NumaDVec>( grid, "First touch allocator (dg::NumaDVec)");
+    return 0;
+}
@@ -8,6 +8,7 @@
 
 #include "blas.h"
 #include "functors.h"
+#include "backend/memory.h"
 /*!@file
  * LGMRES class
  *
@@ -57,6 +58,7 @@ class LGMRES
      * @param max_inner Maximum number of vectors to be saved in gmres. Usually 30 seems to be a decent number.
      * @param max_outer Maximum number of solutions saved for restart. Usually 3-10 seems to be a good number.
      * @param Restarts Maximum number of restarts. This can be set high just in case. Like e.g. gridsize/max_outer.
+     * @note Removes a workspace set with \c set_workspace
      */
     void construct(const ContainerType& copyable, unsigned max_outer, unsigned max_inner, unsigned Restarts){
         outer_k = max_outer;
@@ -89,6 +91,27 @@ class LGMRES
         z = copyable;
         dx = copyable;
         residual = copyable;
+        m_ws = nullptr;
+    }
+    /**
+     * @brief Borrow all Krylov vectors and temporaries from a shared workspace
+     *
+     * The memory held by this object (<tt> 2(max_inner+max_outer)+max_outer+4 </tt>
+     * containers) is freed and every solve borrows it from \c ws instead,
+     * such that other objects can use the same memory between solves
+     * @param ws containers in \c ws must have the size of the copyable used in \c construct; if \c nullptr
+     * the memory is allocated and owned by this object again
+     */
+    void set_workspace( std::shared_ptr<Workspace<ContainerType>> ws){
+        if( ws || m_ws)
+        {
+            ContainerType copyable = ws ? ContainerType() : m_ws->copyable();
+            for( auto& v : V) v = copyable;
+            for( auto& v : W) v = copyable;
+            for( auto& v : outer_v) v = copyable;
+            z = dx = residual = copyable;
+        }
+        m_ws = ws;
     }
 
     /**
@@ -122,6 +145,7 @@ class LGMRES
     std::vector<ContainerType> V, W, outer_v;
     std::vector<value_type> s;
     unsigned numberRestarts, inner_m, outer_k, krylovDimension;
+    std::shared_ptr<Workspace<ContainerType>> m_ws;
 };
 ///@cond
 
@@ -155,6 +179,15 @@ template< class ContainerType>
 template< class Matrix, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm>
 unsigned LGMRES< ContainerType>::solve( Matrix& A, ContainerType0& x, const ContainerType1& b, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction)
 {
+    //all containers hold memory of the workspace until we return
+    std::vector<typename Workspace<ContainerType>::Temporary> borrowed, borrowedV, borrowedW, borrowed_outer;
+    if( m_ws)
+    {
+        borrowed = m_ws->borrow( {&z, &dx, &residual});
+        borrowedV = m_ws->borrow( V);
+        borrowedW = m_ws->borrow( W);
+        borrowed_outer = m_ws->borrow( outer_v);
+    }
     dg::blas2::symv(A,x,residual);
     dg::blas1::axpby(1.,b,-1.,residual);
     dg::blas2::symv(P,residual,residual);
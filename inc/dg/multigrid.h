@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 #include "backend/exceptions.h"
 #include "backend/memory.h"
 #include "topology/fast_interpolation.h"
@@ -162,6 +165,16 @@ struct MultigridCG2d
     ///@brief Return an object of same size as the object used for construction on the finest grid
     ///@return A copyable object; what it contains is undefined, its size is important
     const Container& copyable() const {return m_x[0];}
+    /**
+     * @brief Let the solver on the finest grid borrow its temporaries from a shared workspace
+     *
+     * @param ws containers in \c ws must have the size of \c copyable(); if \c nullptr
+     * the temporaries are allocated and owned by this object again
+     * @sa CG::set_workspace
+     */
+    void set_workspace( std::shared_ptr<Workspace<Container>> ws){
+        m_cg[0].set_workspace( ws);
+    }
     /**
      * @brief USE THIS ONE Nested iterations
      *
@@ -199,36 +212,14 @@ struct MultigridCG2d
         // compute residual r = Wb - A x
         dg::blas2::symv(op[0], x, m_r[0]);
         dg::blas1::axpby(-1.0, m_r[0], 1.0, m_b[0], m_r[0]);
-        // project residual down to coarse grid
-        for( unsigned u=0; u<m_stages-1; u++)
-            dg::blas2::gemv( m_interT[u], m_r[u], m_r[u+1]);
+        // project residual down to first coarse grid
+        dg::blas2::gemv( m_interT[0], m_r[0], m_r[1]);
         std::vector<unsigned> number(m_stages);
-#ifdef DG_BENCHMARK
-        Timer t;
-#endif //DG_BENCHMARK
-
-        dg::blas1::scal( m_x[m_stages-1], 0.0);
         //now solve residual equations
-		for( unsigned u=m_stages-1; u>0; u--)
-        {
-#ifdef DG_BENCHMARK
-            t.tic();
-#endif //DG_BENCHMARK
-            number[u] = m_cg[u]( op[u], m_x[u], m_r[u], op[u].precond(),
-                op[u].inv_weights(), eps[u], 1., 10);
-            dg::blas2::symv( m_inter[u-1], m_x[u], m_x[u-1]);
-#ifdef DG_BENCHMARK
-            t.toc();
-#ifdef MPI_VERSION
-            int rank;
-            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-            if(rank==0)
-#endif //MPI
-            std::cout << "# Nested iterations stage: " << u << ", iter: " << number[u] << ", took "<<t.diff()<<"s\n";
-#endif //DG_BENCHMARK
-
-        }
+        solve_residual_equations( op, 1, eps, 1., number);
+        dg::blas2::symv( m_inter[0], m_x[1], m_x[0]);
 #ifdef DG_BENCHMARK
+        Timer t;
         t.tic();
 #endif //DG_BENCHMARK
 
@@ -249,6 +240,129 @@ struct MultigridCG2d
         return number;
     }
 
+    /**
+     * @brief Mixed precision nested iterations
+     *
+     * Same as \c direct_solve but the coarse stages (and optionally the fine
+     * stage) are solved in a lower precision (typically \c float) by a second
+     * multigrid object \c fmg. This halves the memory traffic in the lower
+     * precision stages.
+     * -# If \c float_fine_cg is \c false, the residual is projected to the
+     *  first coarse grid and converted to the lower precision, the coarse
+     *  stages are solved as in \c direct_solve and the result is converted
+     *  back and interpolated. The final CG on the fine grid is done in
+     *  double precision to the accuracy \c eps.
+     * -# If \c float_fine_cg is \c true, all stages are solved in the lower
+     *  precision and iterative refinement is used: the residual \f$ r = Wb - Ax\f$ is
+     *  computed in double precision, the correction equation
+     *  \f$ A\delta = r\f$ is solved with nested iterations in the lower
+     *  precision and \f$ x \leftarrow x + \delta\f$. This is repeated until
+     *  \f$ ||r|| < \epsilon( ||Wb|| + 1)\f$.
+     *
+     * The accuracy of the lower precision stages is limited from below by
+     * \f$ 10\epsilon_{\rm float}\f$ of the lower precision type. In the
+     * iterative refinement each sweep reduces the residual by at most
+     * \f$ \sqrt{\epsilon_{\rm float}}\f$ since the true residual of the low
+     * precision CG stagnates at about that level for typical condition numbers.
+     * The refinement pays off mainly for small \c eps.
+     * @snippet elliptic2d_b.cu mixed
+     * @copydoc hide_symmetric_op
+     * @tparam FloatSymmetricOp The \c SymmetricOp type in the lower precision
+     * (e.g. \c dg::Elliptic<dg::aRealGeometry2d<float>, dg::fDMatrix, dg::fDVec>)
+     * @tparam ContainerTypes must be usable with \c Container in \ref dispatch
+     * @param op Index 0 is the \c SymmetricOp on the original grid, 1 on the half grid, 2 on the quarter grid, ...
+     * @param fmg A multigrid object in the lower precision, constructed with
+     * the same grid (in the lower precision) and the same number of stages as this object
+     * @param fop The \c op vector in the lower precision constructed on the grids of \c fmg
+     * @param x (read/write) contains initial guess on input and the solution on output
+     * @param b The right hand side (will be multiplied by \c weights)
+     * @param eps the accuracy: iteration stops if \f$ ||b - Ax|| < \epsilon(
+     * ||b|| + 1) \f$. The coarse stages use \c 1.5*eps
+     * @param float_fine_cg If \c true the fine grid CG is also done in the
+     *  lower precision and the accuracy is reached by iterative refinement
+     * @return the number of iterations in each of the stages beginning with
+     * the finest grid (summed over all refinement sweeps). If the iterative
+     * refinement does not converge \c max_iter() is returned in the first element
+     * @note If the Macro \c DG_BENCHMARK is defined this function will write timings to \c std::cout
+    */
+    template<class SymmetricOp, class FloatGeometry, class FloatMatrix, class FloatContainer, class FloatSymmetricOp, class ContainerType0, class ContainerType1>
+    std::vector<unsigned> mixed_precision_solve( std::vector<SymmetricOp>& op,
+        MultigridCG2d<FloatGeometry, FloatMatrix, FloatContainer>& fmg,
+        std::vector<FloatSymmetricOp>& fop,
+        ContainerType0&  x, const ContainerType1& b, value_type eps,
+        bool float_fine_cg = false)
+    {
+        using float_type = get_value_type<FloatContainer>;
+        const float_type eps_min = 10*std::numeric_limits<float_type>::epsilon();
+        std::vector<float_type> f_eps( m_stages, std::max<float_type>( 1.5*eps, eps_min));
+        std::vector<unsigned> number(m_stages, 0);
+
+        dg::blas2::symv(op[0].weights(), b, m_b[0]);
+        // compute residual r = Wb - A x
+        dg::blas2::symv(op[0], x, m_r[0]);
+        dg::blas1::axpby(-1.0, m_r[0], 1.0, m_b[0], m_r[0]);
+        if( !float_fine_cg)
+        {
+            // project residual down to first coarse grid and solve in low precision
+            dg::blas2::gemv( m_interT[0], m_r[0], m_r[1]);
+            dg::blas1::copy( m_r[1], fmg.m_r[1]);
+            std::vector<unsigned> f_number(m_stages, 0);
+            fmg.solve_residual_equations( fop, 1, f_eps, 1., f_number);
+            for( unsigned u=1; u<m_stages; u++)
+                number[u] = f_number[u];
+            dg::blas1::copy( fmg.m_x[1], m_x[1]);
+            dg::blas2::symv( m_inter[0], m_x[1], m_x[0]);
+            //update initial guess
+            dg::blas1::axpby( 1., m_x[0], 1., x);
+            number[0] = m_cg[0]( op[0], x, m_b[0], op[0].precond(),
+                op[0].inv_weights(), eps);
+            return number;
+        }
+        // iterative refinement: the correction equations are solved in low
+        // precision to the relative accuracy needed to reach eps; the true
+        // residual of a low precision CG stagnates early so we never ask
+        // for more than sqrt(epsilon) per sweep
+        const float_type eps_sweep = sqrt( std::numeric_limits<float_type>::epsilon());
+        const value_type nrmb = sqrt( blas2::dot( op[0].inv_weights(), m_b[0]));
+        if( nrmb == 0)
+        {
+            dg::blas1::copy( 0., x);
+            return number;
+        }
+        value_type error = sqrt( blas2::dot( op[0].inv_weights(), m_r[0]));
+        const unsigned max_sweeps = 100;
+        for( unsigned k=0; k<max_sweeps; k++)
+        {
+#ifdef DG_BENCHMARK
+#ifdef MPI_VERSION
+            int rank;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            if(rank==0)
+#endif //MPI
+            std::cout << "# Iterative refinement sweep: " << k << ", residual: " << error/(nrmb+1) << "\n";
+#endif //DG_BENCHMARK
+            if( error < eps*(nrmb + 1))
+                return number;
+            value_type eps_k = eps*(nrmb + 1)/error;
+            for( unsigned u=0; u<m_stages; u++)
+                f_eps[u] = std::max<float_type>( u==0 ? eps_k : 1.5*eps_k, eps_sweep);
+            dg::blas1::copy( m_r[0], fmg.m_r[0]);
+            std::vector<unsigned> f_number(m_stages, 0);
+            fmg.solve_residual_equations( fop, 0, f_eps, 0., f_number);
+            for( unsigned u=0; u<m_stages; u++)
+                number[u] += f_number[u];
+            dg::blas1::copy( fmg.m_x[0], m_x[0]);
+            dg::blas1::axpby( 1., m_x[0], 1., x);
+            // recompute residual in high precision
+            dg::blas2::symv(op[0], x, m_r[0]);
+            dg::blas1::axpby(-1.0, m_r[0], 1.0, m_b[0], m_r[0]);
+            error = sqrt( blas2::dot( op[0].inv_weights(), m_r[0]));
+        }
+        if( error >= eps*(nrmb + 1))
+            number[0] = max_iter();
+        return number;
+    }
+
     /**
      * @brief EXPERIMENTAL Nested iterations with Chebyshev as preconditioner for CG
      *
@@ -499,6 +613,46 @@ struct MultigridCG2d
 
     }
   private:
+    template<class G, class M, class C>
+    friend struct MultigridCG2d;
+    // Solve the residual equations op[u] m_x[u] = m_r[u] from the coarsest
+    // stage up to stage first with the interpolated solution of the coarser
+    // stage as initial guess; m_r[first] must contain the residual on input,
+    // on output m_x[first] contains the solution
+    template<class SymmetricOp>
+    void solve_residual_equations( std::vector<SymmetricOp>& op,
+        unsigned first, const std::vector<value_type>& eps,
+        value_type nrmb_correction, std::vector<unsigned>& number)
+    {
+        // project residual down to coarse grid
+        for( unsigned u=first; u<m_stages-1; u++)
+            dg::blas2::gemv( m_interT[u], m_r[u], m_r[u+1]);
+#ifdef DG_BENCHMARK
+        Timer t;
+#endif //DG_BENCHMARK
+
+        dg::blas1::scal( m_x[m_stages-1], 0.0);
+        for( unsigned u=m_stages; u>first; u--)
+        {
+            unsigned s = u-1;
+#ifdef DG_BENCHMARK
+            t.tic();
+#endif //DG_BENCHMARK
+            number[s] = m_cg[s]( op[s], m_x[s], m_r[s], op[s].precond(),
+                op[s].inv_weights(), eps[s], nrmb_correction, 10);
+            if( s > first)
+                dg::blas2::symv( m_inter[s-1], m_x[s], m_x[s-1]);
+#ifdef DG_BENCHMARK
+            t.toc();
+#ifdef MPI_VERSION
+            int rank;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            if(rank==0)
+#endif //MPI
+            std::cout << "# Nested iterations stage: " << s << ", iter: " << number[s] << ", took "<<t.diff()<<"s\n";
+#endif //DG_BENCHMARK
+        }
+    }
     template<class SymmetricOp>
     void multigrid_cycle( std::vector<SymmetricOp>& op,
     std::vector<Container>& x, std::vector<Container>& b,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include "backend/binary_io.h"
 #include "implicit.h"
 #include "runge_kutta.h"
 #include "multistep_tableau.h"
@@ -162,6 +163,43 @@ struct ImExMultistep
     template< class Explicit, class Implicit>
     void step( Explicit& ex, Implicit& im, value_type& t, ContainerType& u);
 
+    /**
+     * @brief Write the state of the integrator to a binary stream
+     *
+     * The state consists of the current time, the timestep, the number of
+     * Runge-Kutta startup steps taken and the stored
+     * values and right hand sides of the previous steps. Together with
+     * \c load a simulation can be restarted without the startup steps and
+     * continues exactly like the uninterrupted run.
+     * @param os output stream (opened with \c std::ios::binary)
+     * @note The solver is not saved (the default solvers keep no state
+     * between steps)
+     * @sa dg::write_binary
+     */
+    void save( std::ostream& os) const{
+        dg::write_binary( os, m_counter);
+        dg::write_binary( os, m_tu);
+        dg::write_binary( os, m_dt);
+        dg::write_binary( os, m_u);
+        dg::write_binary( os, m_ex);
+        dg::write_binary( os, m_im);
+    }
+    /**
+     * @brief Read the state written by \c save (replaces a call to \c init)
+     *
+     * @param is input stream (opened with \c std::ios::binary)
+     * @throw dg::Error if the stored sizes do not match (e.g. a different tableau was used)
+     * @note the explicit and implicit parts are not called, so their state has to be restored separately
+     */
+    void load( std::istream& is){
+        dg::read_binary( is, m_counter);
+        dg::read_binary( is, m_tu);
+        dg::read_binary( is, m_dt);
+        dg::read_binary( is, m_u);
+        dg::read_binary( is, m_ex);
+        dg::read_binary( is, m_im);
+    }
+
   private:
     dg::MultistepTableau<value_type> m_t;
     SolverType m_solver;
@@ -616,6 +654,39 @@ struct FilteredExplicitMultistep
     template< class RHS, class Limiter>
     void step( RHS& rhs, Limiter& limiter, value_type& t, ContainerType& u);
 
+    /**
+     * @brief Write the state of the integrator to a binary stream
+     *
+     * The state consists of the current time, the timestep, the number of
+     * Runge-Kutta startup steps taken and the stored
+     * values and right hand sides of the previous steps. Together with
+     * \c load a simulation can be restarted without the startup steps and
+     * continues exactly like the uninterrupted run.
+     * @param os output stream (opened with \c std::ios::binary)
+     * @sa dg::write_binary
+     */
+    void save( std::ostream& os) const{
+        dg::write_binary( os, m_counter);
+        dg::write_binary( os, m_tu);
+        dg::write_binary( os, m_dt);
+        dg::write_binary( os, m_u);
+        dg::write_binary( os, m_f);
+    }
+    /**
+     * @brief Read the state written by \c save (replaces a call to \c init)
+     *
+     * @param is input stream (opened with \c std::ios::binary)
+     * @throw dg::Error if the stored sizes do not match (e.g. a different tableau was used)
+     * @note the rhs is not called, so its state has to be restored separately
+     */
+    void load( std::istream& is){
+        dg::read_binary( is, m_counter);
+        dg::read_binary( is, m_tu);
+        dg::read_binary( is, m_dt);
+        dg::read_binary( is, m_u);
+        dg::read_binary( is, m_f);
+    }
+
   private:
     dg::MultistepTableau<value_type> m_t;
     std::vector<ContainerType> m_u, m_f;
@@ -757,6 +828,10 @@ struct ExplicitMultistep
         dg::IdentityFilter id;
         m_fem.step( rhs, id, t, u);
     }
+    ///@copydoc FilteredExplicitMultistep::save
+    void save( std::ostream& os) const{ m_fem.save( os);}
+    ///@copydoc FilteredExplicitMultistep::load
+    void load( std::istream& is){ m_fem.load( is);}
 
   private:
     FilteredExplicitMultistep<ContainerType> m_fem;
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <iomanip>
 #include <functional>
+#include <sstream>
 
 #undef DG_DEBUG
 #include "multistep.h"
@@ -161,6 +162,73 @@ int main()
         std::cout << "Relative error: "<<std::setw(20) <<name<<"\t"<< res.d<<"\t"<<res.i<<std::endl;
     }
 
+    std::cout << "### Test restart from a binary checkpoint (difference to uninterrupted run)\n";
+    for( unsigned k_save : {1u, 20u}) //in the Runge-Kutta startup and later
+    {
+        time = 0., y0 = init;
+        dg::ExplicitMultistep< std::array<double,2> > ab( "TVB-3-3", y0);
+        dg::ImExMultistep< std::array<double,2>, ImplicitSolver > imex( "ImEx-BDF-3-3", nu);
+        std::array<double,2> y1( y0);
+        double time1 = time;
+        ab.init( full, time, y0, dt);
+        imex.init( ex, im, time1, y1, dt);
+        std::stringstream checkpoint;
+        for( unsigned k=0; k<NT; k++)
+        {
+            if( k == k_save)
+            {
+                ab.save( checkpoint);
+                imex.save( checkpoint);
+                dg::write_binary( checkpoint, y0);
+                dg::write_binary( checkpoint, y1);
+                dg::write_binary( checkpoint, time);
+                dg::write_binary( checkpoint, time1);
+            }
+            ab.step( full, time, y0);
+            imex.step( ex, im, time1, y1);
+        }
+        dg::ExplicitMultistep< std::array<double,2> > ab_r( "TVB-3-3", init);
+        dg::ImExMultistep< std::array<double,2>, ImplicitSolver > imex_r( "ImEx-BDF-3-3", nu);
+        std::array<double,2> y0_r, y1_r;
+        double time_r, time1_r;
+        ab_r.load( checkpoint);
+        imex_r.load( checkpoint);
+        dg::read_binary( checkpoint, y0_r);
+        dg::read_binary( checkpoint, y1_r);
+        dg::read_binary( checkpoint, time_r);
+        dg::read_binary( checkpoint, time1_r);
+        for( unsigned k=k_save; k<NT; k++)
+        {
+            ab_r.step( full, time_r, y0_r);
+            imex_r.step( ex, im, time1_r, y1_r);
+        }
+        dg::exblas::udouble res_r;
+        res.d = y0[0], res_r.d = y0_r[0];
+        std::cout << "Restart after "<<std::setw(2)<<k_save<<" steps:  TVB-3-3 \t"<<res.i-res_r.i<<"\t"<<time-time_r<<"\n";
+        res.d = y1[0], res_r.d = y1_r[0];
+        std::cout << "Restart after "<<std::setw(2)<<k_save<<" steps:  ImEx-BDF-3-3 \t"<<res.i-res_r.i<<"\t"<<time1-time1_r<<"\n";
+    }
+    std::cout << "### Test that mismatching binary data is rejected\n";
+    {
+        std::stringstream checkpoint;
+        dg::write_binary( checkpoint, init);
+        std::array<float,2> wrong_type;
+        try{
+            dg::read_binary( checkpoint, wrong_type);
+            std::cout << "Wrong value type:  FAILED\n";
+        }catch( dg::Error& e){
+            std::cout << "Wrong value type:  PASSED\n";
+        }
+        std::stringstream garbage( "this is not a checkpoint");
+        std::array<double,2> y;
+        try{
+            dg::read_binary( garbage, y);
+            std::cout << "Wrong header:      FAILED\n";
+        }catch( dg::Error& e){
+            std::cout << "Wrong header:      PASSED\n";
+        }
+    }
+
     std::cout << "### Test semi-implicit ARK methods\n";
     std::vector<std::string> names{"ARK-4-2-3", "ARK-6-3-4", "ARK-8-4-5"};
     double rtol = 1e-7, atol = 1e-10;
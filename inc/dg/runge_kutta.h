@@ -5,6 +5,7 @@
 #include <array>
 
 #include "backend/exceptions.h"
+#include "backend/memory.h"
 #include "tableau.h"
 #include "blas1.h"
 #include "implicit.h"
@@ -70,9 +71,35 @@ struct ERKStep
     void construct( ConvertsToButcherTableau<value_type> tableau, const ContainerType& copyable ){
         m_rk = tableau;
         m_k.assign(m_rk.num_stages(), copyable);
+        m_ws = nullptr;
     }
     ///@copydoc RungeKutta::copyable()
     const ContainerType& copyable()const{ return m_k[0];}
+    /**
+     * @brief Borrow the stages \c k_1,...,k_{s-1} from a shared workspace
+     *
+     * The memory of these stages is freed and every step borrows it from
+     * \c ws instead, such that other objects (e.g. the solvers called in
+     * the right hand side) can use the same memory between steps. The first
+     * stage \c k_0 is kept in order to preserve the first same as last property.
+     * @note Stage \c k_i is borrowed right before the right hand side computes it
+     * and all stages are needed for the final sum, so during the computation of
+     * \c k_i the stages \c k_1,...,k_{i-1} are in use and the right hand side can
+     * only share the remaining memory of \c ws. The stages are returned after the
+     * final sum, i.e. before the last call \c rhs(t1,u1) for non-fsal tableaus.
+     * @param ws containers in \c ws must have the size of \c copyable(); if \c nullptr
+     * the stages are allocated and owned by this object again
+     * @note \c construct removes the workspace
+     */
+    void set_workspace( std::shared_ptr<Workspace<ContainerType>> ws){
+        if( ws || m_ws)
+        {
+            ContainerType copyable = ws ? ContainerType() : m_ws->copyable();
+            for( unsigned i=1; i<m_k.size(); i++)
+                m_k[i] = copyable;
+        }
+        m_ws = ws;
+    }
 
     ///All subsequent calls to \c step method will ignore the first same as last property (useful if you want to implement an operator splitting)
     void ignore_fsal(){ m_ignore_fsal = true;}
@@ -100,6 +127,7 @@ struct ERKStep
     std::vector<ContainerType> m_k;
     value_type m_t1 = 1e300;//remember the last timestep at which ERK is called
     bool m_ignore_fsal = false;
+    std::shared_ptr<Workspace<ContainerType>> m_ws;
 };
 
 ///@cond
@@ -108,6 +136,14 @@ template< class RHS>
 void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u0, value_type& t1, ContainerType& u1, value_type dt, ContainerType& delta)
 {
     unsigned s = m_rk.num_stages();
+    //stage k_i borrows its memory right before it is computed, such that
+    //the right hand side of stage i can use the memory of the later stages
+    std::vector<typename Workspace<ContainerType>::Temporary> borrowed;
+    borrowed.reserve( s);
+    auto borrow_stage = [&]( unsigned i){
+        if( m_ws)
+            borrowed.push_back( m_ws->borrow( m_k[i]));
+    };
     //0 stage: probe
     value_type tu = t0;
     if( t0 != m_t1 || m_ignore_fsal)
@@ -117,6 +153,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
     if( s>1) {
         tu = DG_FMA( m_rk.c(1),dt, t0);
         blas1::axpby( 1., u0, dt*m_rk.a(1,0), m_k[0], delta);
+        borrow_stage( 1);
         f( tu, delta, m_k[1]);
     }
     //2 stage
@@ -125,6 +162,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
         blas1::evaluate( delta, dg::equals(), PairSum(), 1., u0,
                             dt*m_rk.a(2,0),m_k[0],
                             dt*m_rk.a(2,1),m_k[1]);
+        borrow_stage( 2);
         f( tu, delta, m_k[2]);
     }
     //3 stage
@@ -134,6 +172,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
                              dt*m_rk.a(3,0),m_k[0],
                              dt*m_rk.a(3,1),m_k[1],
                              dt*m_rk.a(3,2),m_k[2]);
+        borrow_stage( 3);
         f( tu, delta, m_k[3]);
     }
     //4 stage
@@ -142,6 +181,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
         blas1::evaluate( delta, dg::equals(), PairSum(), 1.        , u0,
                              dt*m_rk.a(4,0),m_k[0],  dt*m_rk.a(4,1),m_k[1],
                              dt*m_rk.a(4,2),m_k[2],  dt*m_rk.a(4,3),m_k[3]);
+        borrow_stage( 4);
         f( tu, delta, m_k[4]);
     }
     //5 stage
@@ -151,6 +191,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
                  dt*m_rk.a(5,0),m_k[0], dt*m_rk.a(5,1),m_k[1],
                  dt*m_rk.a(5,2),m_k[2], dt*m_rk.a(5,3),m_k[3],
                  dt*m_rk.a(5,4),m_k[4]);
+        borrow_stage( 5);
         f( tu, delta, m_k[5]);
     }
     //6 stage
@@ -161,6 +202,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
                            dt*m_rk.a(6,0),m_k[0], dt*m_rk.a(6,1),m_k[1],
                            dt*m_rk.a(6,2),m_k[2], dt*m_rk.a(6,3),m_k[3],
                            dt*m_rk.a(6,4),m_k[4], dt*m_rk.a(6,5),m_k[5]);
+        borrow_stage( 6);
         f( tu, delta, m_k[6]);
         for ( unsigned i=7; i<s; i++)
         {
@@ -168,6 +210,7 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
             tu = DG_FMA( dt,m_rk.c(i),t0); //l=0
             for( unsigned l=1; l<i; l++)
                 blas1::axpby( dt*m_rk.a(i,l), m_k[l],1., delta);
+            borrow_stage( i);
             f( tu, delta, m_k[i]);
         }
     }
@@ -235,7 +278,10 @@ void ERKStep<ContainerType>::step( RHS& f, value_type t0, const ContainerType& u
     //make sure (t1,u1) is the last call to f
     m_t1 = t1 = t0 + dt;
     if(!m_rk.isFsal() )
+    {
+        borrowed.clear(); //return the stages before the last call to f
         f(t1,u1,m_k[0]);
+    }
     else
     {
         using std::swap;
@@ -522,10 +568,24 @@ struct RungeKutta
     void construct(ConvertsToButcherTableau<value_type> tableau, const ContainerType& copyable){
         m_erk = ERKStep<ContainerType>( tableau, copyable);
         m_delta = copyable;
+        m_ws = nullptr;
     }
     ///@brief Return an object of same size as the object used for construction
     ///@return A copyable object; what it contains is undefined, its size is important
-    const ContainerType& copyable()const{ return m_delta;}
+    const ContainerType& copyable()const{ return m_erk.copyable();}
+    /**
+     * @brief Borrow the error estimate and the stages from a shared workspace
+     *
+     * @copydetails ERKStep::set_workspace()
+     */
+    void set_workspace( std::shared_ptr<Workspace<ContainerType>> ws){
+        if( ws)
+            m_delta = ContainerType();
+        else if( m_ws)
+            m_delta = m_ws->copyable();
+        m_erk.set_workspace( ws);
+        m_ws = ws;
+    }
     /**
     * @brief Advance one step
     *
@@ -548,6 +608,9 @@ struct RungeKutta
     */
     template<class RHS>
     void step( RHS& rhs, value_type t0, const ContainerType& u0, value_type& t1, ContainerType& u1, value_type dt){
+        typename Workspace<ContainerType>::Temporary borrowed;
+        if( m_ws)
+            borrowed = m_ws->borrow( m_delta);
         m_erk.step( rhs, t0, u0, t1, u1, dt, m_delta);
     }
     ///All subsequent calls to \c step method will ignore the first same as last property (useful if you want to implement an operator splitting)
@@ -565,6 +628,7 @@ struct RungeKutta
   private:
     ERKStep<ContainerType> m_erk;
     ContainerType m_delta;
+    std::shared_ptr<Workspace<ContainerType>> m_ws;
 };
 
 /**
@@ -94,6 +94,44 @@ int main()
         auto b = dg::create::tableau<double>(name);
         std::cout << "Norm of error in "<<std::setw(24) <<name<<"\t"<<sqrt(dg::blas1::dot( u1, u1))<<(b.isFsal()?" (fsal)" : "") <<"\n";
     }
+    std::cout << "Explicit Methods with a shared workspace (difference to owned stages):\n";
+    for( auto name : {"Runge-Kutta-4-4", "Cash-Karp-6-4-5", "Dormand-Prince-7-4-5"})
+    {
+        auto ws = std::make_shared<dg::Workspace<std::array<double,2>>>( u);
+        //the right hand side calls two "solvers" one after the other that
+        //each need 3 temporaries and borrow them from the stepper's workspace
+        const unsigned num_solvers = 2, num_temporaries = 3;
+        auto borrowing = [&]( double t, const std::array<double,2>& y, std::array<double,2>& yp){
+            for( unsigned k=0; k<num_solvers; k++)
+            {
+                std::vector<dg::Workspace<std::array<double,2>>::Temporary> tmp;
+                for( unsigned i=0; i<num_temporaries; i++)
+                    tmp.push_back( ws->borrow());
+                functor( t, y, *tmp[0]);
+                for( unsigned i=1; i<num_temporaries; i++)
+                    dg::blas1::copy( *tmp[i-1], *tmp[i]);
+                dg::blas1::copy( *tmp[num_temporaries-1], yp);
+            }
+        };
+        std::array<double, 2> u0 = solution(t_start, damping, omega_0, omega_drive), u1(u0);
+        dg::RungeKutta<std::array<double,2>> owned( name, u0), shared( name, u0);
+        shared.set_workspace( ws);
+        double t0 = t_start, t1 = t_start;
+        for( unsigned i=0; i<N; i++)
+        {
+            owned.step( functor, t0, u0, t0, u0, dt);
+            shared.step( borrowing, t1, u1, t1, u1, dt);
+        }
+        dg::blas1::axpby( 1., u0 , -1., u1);
+        //owned: all stages, the error estimate and the solvers' own temporaries
+        unsigned num_owned = shared.num_stages()+1 + num_solvers*num_temporaries;
+        //shared: the first stage and the pool (the workspace stores no container)
+        unsigned num_shared = 1 + ws->num_allocated();
+        std::cout << "Difference in "<<std::setw(24) <<name<<"\t"<<sqrt(dg::blas1::dot( u1, u1))
+                  <<" (should be 0)\tcontainers "<<num_shared<<" (owned "<<num_owned<<") "
+                  <<(num_shared < num_owned ? "PASSED" : "FAILED")
+                  <<"\tborrowed "<<ws->num_borrowed()<<" (should be 0)\n";
+    }
     std::cout << "Shu-Osher Methods with "<<N<<" steps:\n";
     names = std::vector<std::string> {
         "SSPRK-2-2",
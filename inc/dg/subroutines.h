@@ -374,4 +374,120 @@ auto compose(UnaryOp f0, Functors... fs) {
 }
 ///@}
 
+///@cond
+namespace detail
+{
+//select the I-th argument of a parameter pack
+template<unsigned I>
+struct PickArg
+{
+    template<class T, class ...Ts>
+DG_DEVICE static auto& get( T& , Ts&... xs){
+        return PickArg<I-1>::get( xs...);
+    }
+};
+template<>
+struct PickArg<0>
+{
+    template<class T, class ...Ts>
+DG_DEVICE static T& get( T& x, Ts&...){
+        return x;
+    }
+};
+
+template<class Subroutine, unsigned ...Is>
+struct OnArgs
+{
+    OnArgs( Subroutine f): m_f(f){}
+    template<class ...Ts>
+DG_DEVICE void operator()( Ts&&... xs){
+        m_f( PickArg<Is>::get( xs...)...);
+    }
+    private:
+    Subroutine m_f;
+};
+}//namespace detail
+///@endcond
+
+///@addtogroup variadic_subroutines
+///@{
+
+/**
+ * @brief Bind a subroutine to a selection of the arguments of a fused sweep
+ *
+ * The returned functor takes an arbitrary number of arguments and calls
+ * \c f with the arguments at the positions \c Is in the given order
+ * @code{.cpp}
+ * //call Axpby on the first and third argument: x2 = 2 x0 + 3 x2
+ * auto op = dg::on<0,2>( dg::Axpby<double>( 2., 3.));
+ * @endcode
+ * @tparam Is zero-based indices of the arguments that are passed to \c f
+ * @param f the subroutine to bind
+ * @return a subroutine to be used in \c dg::fuse
+ * @sa dg::fuse dg::blas1::fuse
+ */
+template<unsigned ...Is, class Subroutine>
+detail::OnArgs<Subroutine, Is...> on( Subroutine f){
+    return detail::OnArgs<Subroutine, Is...>( f);
+}
+
+/**
+ * @brief \f$ f_0(x_0,x_1,...); f_1(x_0, x_1, ...); ...\f$
+ *
+ * Calls a sequence of subroutines on the same set of arguments one after
+ * the other. Used in a \c dg::blas1::subroutine this executes several
+ * elementwise operations in a single sweep through memory.
+ * Since all operations are elementwise the result is exactly the same as
+ * calling the operations one after the other in separate sweeps.
+ * @tparam Ops Subroutines that can be called with all arguments (typically generated with \c dg::on)
+ * @sa dg::fuse dg::blas1::fuse
+ */
+template<class Op, class ...Ops>
+struct FusedSubroutine
+{
+    FusedSubroutine( Op op, Ops... ops): m_op( op), m_ops( ops...){}
+    template<class ...Ts>
+DG_DEVICE void operator()( Ts&&... xs){
+        m_op( xs...);
+        m_ops( xs...);
+    }
+    private:
+    Op m_op;
+    FusedSubroutine<Ops...> m_ops;
+};
+///@cond
+template<class Op>
+struct FusedSubroutine<Op>
+{
+    FusedSubroutine( Op op): m_op( op){}
+    template<class ...Ts>
+DG_DEVICE void operator()( Ts&&... xs){
+        m_op( xs...);
+    }
+    private:
+    Op m_op;
+};
+///@endcond
+
+/**
+ * @brief Create a \c dg::FusedSubroutine
+ *
+ * @code{.cpp}
+ * //y = 2x + 3y;  z = x*y*z  in one sweep
+ * dg::blas1::subroutine( dg::fuse(
+ *         dg::on<0,1>( dg::Axpby<double>( 2., 3.)),
+ *         dg::on<0,1,2>( dg::PointwiseDot<double>( 1., 0.))),
+ *     x, y, z);
+ * @endcode
+ * @param op first subroutine to call
+ * @param ops subroutines to call afterwards in the given order
+ * @return <tt> dg::FusedSubroutine<Op, Ops...>( op, ops...) </tt>
+ * @sa dg::blas1::fuse
+ */
+template<class Op, class ...Ops>
+FusedSubroutine<Op, Ops...> fuse( Op op, Ops... ops){
+    return FusedSubroutine<Op, Ops...>( op, ops...);
+}
+///@}
+
 }//namespace dg
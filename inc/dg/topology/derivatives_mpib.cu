@@ -29,9 +29,58 @@ dg::bc bcz = dg::DIR;
 typedef dg::RowColDistMat<dg::EllSparseBlockMatDevice<double>, dg::CooSparseBlockMatDevice<double>, dg::NNCD<double>> Matrix;
 typedef dg::MPI_Vector<dg::DVec > Vector;
 
+//Overlap is the time the symv saves compared to first waiting for the halo
+//exchange and then computing all points, relative to the shorter of halo exchange
+//and inner points (1 means perfect overlap, 0 no overlap)
+void overlap( const Matrix& m, const Vector& v, Vector& w, int rank)
+{
+    if( !m.collective().isCommunicating())
+    {
+        if(rank==0)std::cout << "    no communication\n";
+        return;
+    }
+    dg::Timer t;
+    int multi = 100;
+    MPI_Request rqst[4];
+    auto buffer = m.collective().allocate_buffer();
+    const double* v_ptr = thrust::raw_pointer_cast( v.data().data());
+    t.tic();
+    for( int i=0; i<multi; i++)
+    {
+        m.collective().global_gather_init( v_ptr, buffer, rqst);
+        m.collective().global_gather_wait( v_ptr, buffer, rqst);
+    }
+    t.toc();
+    double comm = t.diff()/multi;
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( m.inner_matrix(), v.data(), w.data());
+    t.toc();
+    double inner = t.diff()/multi;
+    t.tic();
+    for( int i=0; i<multi; i++)
+    {
+        m.symv_start( v, rqst);
+        MPI_Waitall( 4, rqst, MPI_STATUSES_IGNORE);
+        dg::blas2::symv( m.inner_matrix(), v.data(), w.data());
+        m.symv_finish( 1., v, w, rqst);
+    }
+    t.toc();
+    double sequential = t.diff()/multi;
+    t.tic();
+    for( int i=0; i<multi; i++)
+        dg::blas2::symv( m, v, w);
+    t.toc();
+    double total = t.diff()/multi;
+    double achieved = (sequential - total)/std::min( comm, inner);
+    if(rank==0)std::cout << "    halo exchange "<<comm<<"s inner points "<<inner<<"s\n"
+                         << "    sequential symv "<<sequential<<"s symv "<<total<<"s overlap "<<achieved<<"\n";
+}
+
 int main(int argc, char* argv[])
 {
-    MPI_Init( &argc, &argv);
+    int provided;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided);
     int rank;
     unsigned n, Nx, Ny,Nz;
     MPI_Comm comm;
@@ -107,6 +156,27 @@ int main(int argc, char* argv[])
     t.toc();
     if(rank==0)std::cout << "JumpZ took "<<t.diff()<<"s\n";
     }
+    if(rank==0)std::cout << "Overlap of communication and computation in DX and DY\n";
+    {
+    Matrix dx = dg::create::dx( g, bcx, dg::centered);
+    Matrix dy = dg::create::dy( g, bcy, dg::centered);
+    const Vector v = dg::evaluate( sinx, g);
+    Vector w( v);
+    if(rank==0)std::cout << "DX\n";
+    overlap( dx, v, w, rank);
+    if(rank==0)std::cout << "DY\n";
+    overlap( dy, v, w, rank);
+    if( provided >= MPI_THREAD_MULTIPLE)
+    {
+        dg::start_progress_thread();
+        if(rank==0)std::cout << "DX with progress thread\n";
+        overlap( dx, v, w, rank);
+        if(rank==0)std::cout << "DY with progress thread\n";
+        overlap( dy, v, w, rank);
+        dg::stop_progress_thread();
+    }
+    else if(rank==0)std::cout << "No MPI_THREAD_MULTIPLE: progress thread not tested\n";
+    }
 
     MPI_Finalize();
     return 0;
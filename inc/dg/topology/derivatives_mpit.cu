@@ -87,6 +87,71 @@ int main(int argc, char* argv[])
         double norm = sqrt(dg::blas2::dot( error, w3d, error)); res.d = norm;
         if(rank==0)std::cout << "Distance to true solution: "<<norm<<"\t"<<res.i-binary3[i]<<"\n";
     }
+    if(rank==0)std::cout << "TEST 3D with persistent requests, neighborhood collectives and shared windows\n";
+    for( auto policy : {dg::HaloExchangePolicy::persistent, dg::HaloExchangePolicy::neighbor_alltoallw, dg::HaloExchangePolicy::shared_window})
+    {
+        dg::set_halo_exchange_policy( policy);
+        //the shared window is created together with the matrix
+        Matrix mp[] = {dg::create::dx( g3d, dg::forward), dg::create::dy( g3d, dg::centered),
+            dg::create::dz( g3d, dg::backward), dg::create::jumpX( g3d),
+            dg::create::jumpY( g3d), dg::create::jumpZ( g3d)};
+        for( unsigned i=0; i<6; i++)
+        {
+            Vector error = sol3[i];
+            dg::blas2::symv( mp[i], f3d, error);
+            error = sol3[i];
+            dg::blas2::symv( -1., mp[i], f3d, 1., error); //reuse requests
+            double norm = sqrt(dg::blas2::dot( error, w3d, error)); res.d = norm;
+            if(rank==0)std::cout << "Distance to true solution: "<<norm<<"\t"<<res.i-binary3[i]<<"\n";
+        }
+    }
+    dg::set_halo_exchange_policy( dg::HaloExchangePolicy::isend_irecv);
+    if(rank==0)std::cout << "TEST 3D with derived datatypes for the halo layers (isend_irecv and persistent requests)\n";
+    dg::set_halo_packing_policy( dg::HaloPackingPolicy::derived_datatype);
+    for( auto policy : {dg::HaloExchangePolicy::isend_irecv, dg::HaloExchangePolicy::persistent})
+    {
+        dg::set_halo_exchange_policy( policy);
+        for( unsigned i=0; i<6; i++)
+        {
+            Vector error = sol3[i];
+            dg::blas2::symv( -1., m3[i], f3d, 1., error);
+            double norm = sqrt(dg::blas2::dot( error, w3d, error)); res.d = norm;
+            if(rank==0)std::cout << "Distance to true solution: "<<norm<<"\t"<<res.i-binary3[i]<<"\n";
+        }
+    }
+    dg::set_halo_packing_policy( dg::HaloPackingPolicy::pack);
+    dg::set_halo_exchange_policy( dg::HaloExchangePolicy::isend_irecv);
+    if(rank==0)std::cout << "TEST 3D: DX, DY, DZ in one batch (difference to separate symv)\n";
+    std::vector<Vector> batch( 3, f3d);
+    dg::blas2::symv_batch( std::vector<const Matrix*>{&dx3, &dy3, &dz3}, f3d,
+        std::vector<Vector*>{&batch[0], &batch[1], &batch[2]});
+    for( unsigned i=0; i<3; i++)
+    {
+        Vector error = f3d;
+        dg::blas2::symv( m3[i], f3d, error);
+        dg::blas1::axpby( 1., batch[i], -1., error);
+        double norm = sqrt(dg::blas2::dot( error, w3d, error)); res.d = norm;
+        if(rank==0)std::cout << "Distance to separate symv:  "<<norm<<"\t"<<res.i<<"\n";
+    }
+    if(rank==0)std::cout << "TEST 3D: F, DX, DY, DZ on a grid not divisible by the process grid (difference to serial)\n";
+    dg::MPIGrid3d g3u( 0, M_PI, 0.1, 2*M_PI+0.1, M_PI/2., M_PI, n, Nx+1, Ny+3, Nz+1, bcx, bcy, bcz, comm3d);
+    const Vector w3u = dg::create::weights( g3u), f3u = dg::evaluate( sine, g3u);
+    const dg::HVec w3s = dg::create::weights( g3u.global()), f3s = dg::evaluate( sine, g3u.global());
+    Matrix m3u[] = { dg::create::dx( g3u, dg::forward), dg::create::dy( g3u, dg::centered), dg::create::dz( g3u, dg::backward)};
+    dg::HMatrix m3s[] = { dg::create::dx( g3u.global(), dg::forward), dg::create::dy( g3u.global(), dg::centered), dg::create::dz( g3u.global(), dg::backward)};
+    dg::exblas::udouble res_s;
+    res.d = dg::blas1::dot( w3u, f3u), res_s.d = dg::blas1::dot( w3s, f3s);
+    if(rank==0)std::cout << "Distance to serial result:  "<<res.d<<"\t"<<res.i-res_s.i<<"\n";
+    for( unsigned i=0; i<3; i++)
+    {
+        Vector derivative = f3u;
+        dg::HVec derivative_s = f3s;
+        dg::blas2::symv( m3u[i], f3u, derivative);
+        dg::blas2::symv( m3s[i], f3s, derivative_s);
+        res.d = dg::blas2::dot( derivative, w3u, derivative);
+        res_s.d = dg::blas2::dot( derivative_s, w3s, derivative_s);
+        if(rank==0)std::cout << "Distance to serial result:  "<<res.d<<"\t"<<res.i-res_s.i<<"\n";
+    }
     if(rank==0)std::cout << "\nFINISHED! Continue with arakawa_mpit.cu !\n\n";
 
 
@@ -69,6 +69,21 @@ int main(int argc, char** argv)
     double sol3d = (exp(2.)-exp(1))*(exp(4.)-exp(3))*(exp(6.)-exp(5));
     if(rank==0)std::cout << "Correct integral is       "<<std::setw(6)<<sol3d<<std::endl;
     if(rank==0)std::cout << "Relative 3d error is      "<<(integral3d-sol3d)/sol3d<<"\n\n";
+    std::vector<const dg::MDVec*> xs = {&w3d, &func3d}, ys = {&func3d, &func3d};
+    std::vector<double> batch = dg::blas1::dot_batch( xs, ys); res.d = batch[0];
+    if(rank==0)std::cout << "3D integral (batched dot) "<<std::setw(6)<<batch[0] <<"\t" << res.i - 4675882723962622631<< "\n";
+    res.d = batch[1]; dg::exblas::udouble res2; res2.d = dg::blas1::dot( func3d, func3d);
+    if(rank==0)std::cout << "Unweighted norm (batched) "<<std::setw(6)<<batch[1] <<"\t" << res.i - res2.i<< "\n";
+    auto future = dg::blas1::dot_async( w3d, func3d); res.d = future.get();
+    if(rank==0)std::cout << "3D integral (async dot)   "<<std::setw(6)<<res.d <<"\t" << res.i - 4675882723962622631<< "\n";
+    dg::exblas::set_mpi_reduction_scheme( dg::exblas::MPIReductionScheme::single_allreduce);
+    res.d = dg::blas1::dot( w3d, func3d);
+    if(rank==0)std::cout << "3D integral (1 Allreduce) "<<std::setw(6)<<res.d <<"\t" << res.i - 4675882723962622631<< "\n";
+    res.d = dg::blas1::dot_async( w3d, func3d).get();
+    if(rank==0)std::cout << "3D integral (async, 1 Allreduce) "<<std::setw(6)<<res.d <<"\t" << res.i - 4675882723962622631<< "\n";
+    batch = dg::blas1::dot_batch( xs, ys); res.d = batch[1];
+    if(rank==0)std::cout << "Unweighted norm (batched, 1 Allreduce) "<<std::setw(6)<<batch[1] <<"\t" << res.i - res2.i<< "\n\n";
+    dg::exblas::set_mpi_reduction_scheme( dg::exblas::MPIReductionScheme::two_step);
 
     double norm2d = dg::blas2::dot( w2d, func2d); res.d = norm2d;
     if(rank==0)std::cout << "Square normalized 2D norm "<<std::setw(6)<<norm2d<<"\t" << res.i - 4635333359953759707<<"\n";
@@ -86,6 +86,13 @@ int main()
     double sol3d = (exp(2.)-exp(1))*(exp(4.)-exp(3))*(exp(6.)-exp(5));
     std::cout << "Correct integral is       "<<std::setw(6)<<sol3d<<std::endl;
     std::cout << "Relative 3d error is      "<<(integral3d-sol3d)/sol3d<<"\n\n";
+    std::vector<const dg::DVec*> xs = {&w3d, &func3d}, ys = {&func3d, &func3d};
+    std::vector<double> batch = dg::blas1::dot_batch( xs, ys); res.d = batch[0];
+    std::cout << "3D integral (batched dot) "<<std::setw(6)<<batch[0] <<"\t" << res.i - 4675882723962622631<< "\n";
+    res.d = batch[1]; dg::exblas::udouble res2; res2.d = dg::blas1::dot( func3d, func3d);
+    std::cout << "Unweighted norm (batched) "<<std::setw(6)<<batch[1] <<"\t" << res.i - res2.i<< "\n";
+    auto future = dg::blas1::dot_async( w3d, func3d); res.d = future.get();
+    std::cout << "3D integral (async dot)   "<<std::setw(6)<<res.d <<"\t" << res.i - 4675882723962622631<< "\n\n";
 
     double norm = dg::blas2::dot( func1d, w1d, func1d); res.d = norm;
     std::cout << "Square normalized 1D norm "<<std::setw(6)<<norm<<"\t" << res.i - 4627337306989890294 <<"\n";
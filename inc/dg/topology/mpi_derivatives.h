@@ -77,46 +77,55 @@ CooSparseBlockMat<real_type> save_outer_values(EllSparseBlockMat<real_type>& in,
 }
 
 /**
-* @brief Partition a global matrix into equal chunks among mpi processes
+* @brief Partition a global matrix into chunks among mpi processes
 *
 * grab the local rows of column and data indices and remap the column indices to vector with ghostcells
 * copy the whole data array
 * @param coord The mpi proces coordinate of the proper dimension
-* @param howmany[3] # of processes 0 is left, 1 is the middle, 2 is right
+* @param howmany # of processes in the proper dimension
+* @param vector_dimensions the local vector dimensions (x, y, z)
+* @param direction the proper dimension (0, 1 or 2)
 * @return The reduced matrix
 */
 template<class real_type>
-EllSparseBlockMat<real_type> distribute_rows( const EllSparseBlockMat<real_type>& src, int coord, const int* howmany)
+EllSparseBlockMat<real_type> distribute_rows( const EllSparseBlockMat<real_type>& src, int coord, int howmany, const unsigned* vector_dimensions, unsigned direction)
 {
-    if( howmany[1] == 1)
+    int left_size = 1, right_size = 1;
+    for( unsigned u=direction+1; u<3; u++)
+        left_size *= vector_dimensions[u];
+    for( unsigned u=0; u<direction; u++)
+        right_size *= vector_dimensions[u];
+    if( howmany == 1)
     {
         EllSparseBlockMat<real_type> temp(src);
-        temp.left_size = temp.left_size/howmany[0];
-        temp.right_size = temp.right_size/howmany[2];
+        temp.left_size = left_size;
+        temp.right_size = right_size;
         temp.set_default_range();
         return temp;
     }
     assert( src.num_rows == src.num_cols);
-    int chunk_size = src.num_rows/howmany[1];
+    //the chunks differ by one row if num_rows is not divisible by howmany
+    int chunk_size = dg::detail::cells_count( src.num_rows, howmany, coord);
+    int chunk_start = dg::detail::cells_start( src.num_rows, howmany, coord);
     EllSparseBlockMat<real_type> temp(chunk_size, chunk_size, src.blocks_per_line, src.data.size()/(src.n*src.n), src.n);
-    temp.left_size = src.left_size/howmany[0];
-    temp.right_size = src.right_size/howmany[2];
+    temp.left_size = left_size;
+    temp.right_size = right_size;
     //first copy data elements (even though not all might be needed it doesn't slow down things either)
     for( unsigned  i=0; i<src.data.size(); i++)
         temp.data[i] = src.data[i];
     //now grab the right chunk of cols and data indices
     for( unsigned i=0; i<temp.cols_idx.size(); i++)
     {
-        temp.data_idx[i] = src.data_idx[ coord*(chunk_size*src.blocks_per_line)+i];
-        temp.cols_idx[i] = src.cols_idx[ coord*(chunk_size*src.blocks_per_line)+i];
+        temp.data_idx[i] = src.data_idx[ chunk_start*src.blocks_per_line+i];
+        temp.cols_idx[i] = src.cols_idx[ chunk_start*src.blocks_per_line+i];
         //data indices are correct but cols are still the global indices (remapping a bit clumsy)
         //first in the zeroth line the col idx might be (global)num_cols - 1 -> map that to -1
         if( coord==0 && i/src.blocks_per_line == 0 && temp.cols_idx[i] == src.num_cols-1) temp.cols_idx[i] = -1;
         //second in the last line the col idx mighty be 0 -> map to (global)num_cols
-        if( coord==(howmany[1]-1)&& (int)i/src.blocks_per_line == temp.num_rows-1 && temp.cols_idx[i] == 0) temp.cols_idx[i] = src.num_cols;
+        if( coord==(howmany-1)&& (int)i/src.blocks_per_line == temp.num_rows-1 && temp.cols_idx[i] == 0) temp.cols_idx[i] = src.num_cols;
         //Elements are now in the range -1, 0, 1,..., (global)num_cols
         //now shift this range to chunk range -1,..,chunk_size
-        temp.cols_idx[i] = (temp.cols_idx[i] - coord*chunk_size );
+        temp.cols_idx[i] = (temp.cols_idx[i] - chunk_start );
     }
     temp.set_default_range();
     return temp;
@@ -150,9 +159,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {dims[1], dims[0], 1}; //left, middle, right
-    //distribute_rows, collective and save_outer_values are aware of howmany[1] == 1
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], dims[0], vector_dimensions, 0);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 0);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -180,8 +187,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {1, dims[1], dims[0]};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], dims[1], vector_dimensions, 1);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 1);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -208,8 +214,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {dims[1], dims[0], 1}; //left, middle, right
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], dims[0], vector_dimensions, 0);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 0);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -235,8 +240,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {1, dims[1], dims[0]};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], dims[1], vector_dimensions, 1);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 1);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -264,8 +268,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {dims[2]*dims[1], dims[0], 1};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], dims[0], vector_dimensions, 0);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 0);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -292,8 +295,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {dims[2], dims[1], dims[0]};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], dims[1], vector_dimensions, 1);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 1);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -320,8 +322,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {1, dims[2], dims[1]*dims[0]};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[2], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[2], dims[2], vector_dimensions, 2);
     NNCH<real_type> c( 1, vector_dimensions, comm, 2);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -348,8 +349,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {dims[2]*dims[1], dims[0], 1};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[0], dims[0], vector_dimensions, 0);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 0);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -376,8 +376,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {dims[2], dims[1], dims[0]};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[1], dims[1], vector_dimensions, 1);
     NNCH<real_type> c( g.n(), vector_dimensions, comm, 1);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -403,8 +402,7 @@ RowColDistMat< EllSparseBlockMat<real_type>, CooSparseBlockMat<real_type>, NNCH<
     int dims[ndims], periods[ndims], coords[ndims];
     MPI_Cart_get( comm, ndims, dims, periods, coords);
 
-    int howmany[] = {1, dims[2], dims[1]*dims[0]};
-    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[2], howmany);
+    EllSparseBlockMat<real_type> inner = detail::distribute_rows(matrix, coords[2], dims[2], vector_dimensions, 2);
     NNCH<real_type> c( 1, vector_dimensions, comm, 2);
     CooSparseBlockMat<real_type> outer = detail::save_outer_values(inner,c);
 
@@ -40,12 +40,14 @@ MPI_Vector<thrust::host_vector<real_type> > evaluate( const BinaryOp& f, const a
     RealGrid2d<real_type> l = g.local();
     int dims[2], periods[2], coords[2];
     MPI_Cart_get( g.communicator(), 2, dims, periods, coords);
+    unsigned start[2], count[2];
+    g.local_cells( coords, start, count);
     thrust::host_vector<real_type> absx( l.n()*l.Nx());
     thrust::host_vector<real_type> absy( l.n()*l.Ny());
     for( unsigned i=0; i<l.Nx(); i++)
         for( unsigned j=0; j<n; j++)
         {
-            unsigned coord = i+l.Nx()*coords[0];
+            unsigned coord = i+start[0];
             real_type xmiddle = DG_FMA( g.hx(), (real_type)(coord), g.x0());
             real_type h2 = g.hx()/2.;
             real_type absj = 1.+g.dlt().abscissas()[j];
@@ -54,7 +56,7 @@ MPI_Vector<thrust::host_vector<real_type> > evaluate( const BinaryOp& f, const a
     for( unsigned i=0; i<l.Ny(); i++)
         for( unsigned j=0; j<n; j++)
         {
-            unsigned coord = i+l.Ny()*coords[1];
+            unsigned coord = i+start[1];
             real_type ymiddle = DG_FMA( g.hy(), (real_type)(coord), g.y0());
             real_type h2 = g.hy()/2.;
             real_type absj = 1.+g.dlt().abscissas()[j];
@@ -105,13 +107,15 @@ MPI_Vector<thrust::host_vector<real_type> > evaluate( const TernaryOp& f, const
     RealGrid3d<real_type> l = g.local();
     int dims[3], periods[3], coords[3];
     MPI_Cart_get( g.communicator(), 3, dims, periods, coords);
+    unsigned start[3], count[3];
+    g.local_cells( coords, start, count);
     thrust::host_vector<real_type> absx( l.n()*l.Nx());
     thrust::host_vector<real_type> absy( l.n()*l.Ny());
     thrust::host_vector<real_type> absz(       l.Nz());
     for( unsigned i=0; i<l.Nx(); i++)
         for( unsigned j=0; j<n; j++)
         {
-            unsigned coord = i+l.Nx()*coords[0];
+            unsigned coord = i+start[0];
             real_type xmiddle = DG_FMA( g.hx(), (real_type)(coord), g.x0());
             real_type h2 = g.hx()/2.;
             real_type absj = 1.+g.dlt().abscissas()[j];
@@ -120,7 +124,7 @@ MPI_Vector<thrust::host_vector<real_type> > evaluate( const TernaryOp& f, const
     for( unsigned i=0; i<l.Ny(); i++)
         for( unsigned j=0; j<n; j++)
         {
-            unsigned coord = i+l.Ny()*coords[1];
+            unsigned coord = i+start[1];
             real_type ymiddle = DG_FMA( g.hy(), (real_type)(coord), g.y0());
             real_type h2 = g.hy()/2.;
             real_type absj = 1.+g.dlt().abscissas()[j];
@@ -128,7 +132,7 @@ MPI_Vector<thrust::host_vector<real_type> > evaluate( const TernaryOp& f, const
         }
     for( unsigned i=0; i<l.Nz(); i++)
     {
-        unsigned coord = i+l.Nz()*coords[2];
+        unsigned coord = i+start[2];
         real_type zmiddle = DG_FMA( g.hz(), (real_type)(coord), g.z0());
         real_type h2 = g.hz()/2.;
         absz[i] = DG_FMA( h2, (1.), zmiddle );
@@ -170,16 +174,16 @@ MPI_Vector<thrust::host_vector<real_type> > global2local( const thrust::host_vec
     thrust::host_vector<real_type> temp(l.size());
     int dims[3], periods[3], coords[3];
     MPI_Cart_get( g.communicator(), 3, dims, periods, coords);
+    unsigned start[3], count[3];
+    g.local_cells( coords, start, count);
     for( unsigned s=0; s<l.Nz(); s++)
-        //for( unsigned py=0; py<dims[1]; py++)
-            for( unsigned i=0; i<l.n()*l.Ny(); i++)
-                //for( unsigned px=0; px<dims[0]; px++)
-                    for( unsigned j=0; j<l.n()*l.Nx(); j++)
-                    {
-                        unsigned idx1 = (s*l.n()*l.Ny()+i)*l.n()*l.Nx() + j;
-                        unsigned idx2 = (((s*dims[1]+coords[1])*l.n()*l.Ny()+i)*dims[0] + coords[0])*l.n()*l.Nx() + j;
-                        temp[idx1] = global[idx2];
-                    }
+        for( unsigned i=0; i<l.n()*l.Ny(); i++)
+            for( unsigned j=0; j<l.n()*l.Nx(); j++)
+            {
+                unsigned idx1 = (s*l.n()*l.Ny()+i)*l.n()*l.Nx() + j;
+                unsigned idx2 = ((start[2]+s)*g.n()*g.Ny()+start[1]*g.n()+i)*g.n()*g.Nx() + start[0]*g.n() + j;
+                temp[idx1] = global[idx2];
+            }
     return MPI_Vector<thrust::host_vector<real_type> >(temp, g.communicator());
 }
 /**
@@ -194,15 +198,15 @@ MPI_Vector<thrust::host_vector<real_type> > global2local( const thrust::host_vec
     thrust::host_vector<real_type> temp(l.size());
     int dims[2], periods[2], coords[2];
     MPI_Cart_get( g.communicator(), 2, dims, periods, coords);
-    //for( unsigned py=0; py<dims[1]; py++)
-        for( unsigned i=0; i<l.n()*l.Ny(); i++)
-            //for( unsigned px=0; px<dims[0]; px++)
-                for( unsigned j=0; j<l.n()*l.Nx(); j++)
-                {
-                    unsigned idx1 = i*l.n()*l.Nx() + j;
-                    unsigned idx2 = ((coords[1]*l.n()*l.Ny()+i)*dims[0] + coords[0])*l.n()*l.Nx() + j;
-                    temp[idx1] = global[idx2];
-                }
+    unsigned start[2], count[2];
+    g.local_cells( coords, start, count);
+    for( unsigned i=0; i<l.n()*l.Ny(); i++)
+        for( unsigned j=0; j<l.n()*l.Nx(); j++)
+        {
+            unsigned idx1 = i*l.n()*l.Nx() + j;
+            unsigned idx2 = (start[1]*g.n()+i)*g.n()*g.Nx() + start[0]*g.n() + j;
+            temp[idx1] = global[idx2];
+        }
     return MPI_Vector<thrust::host_vector<real_type> >(temp, g.communicator());
 }
 
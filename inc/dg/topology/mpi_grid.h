@@ -26,6 +26,79 @@ template<class real_type>
 struct RealMPIGrid2d;
 template<class real_type>
 struct RealMPIGrid3d;
+
+namespace detail
+{
+//N cells are distributed as evenly as possible among P processes:
+//the first N%P processes hold one cell more than the others
+inline unsigned cells_count( unsigned N, int P, int coord)
+{
+    return N/P + ( (unsigned)coord < N%P ? 1 : 0);
+}
+//global index of the first cell of process coord
+inline unsigned cells_start( unsigned N, int P, int coord)
+{
+    return coord*(N/P) + ( (unsigned)coord < N%P ? coord : N%P);
+}
+//coordinate of the process that holds cell i
+inline int cells_coord( unsigned N, int P, unsigned i)
+{
+    unsigned q = N/P, r = N%P;
+    if( i < r*(q+1))
+        return i/(q+1);
+    return r + (i-r*(q+1))/q;
+}
+//boundaries of the box of process coord
+template<class real_type>
+void cells_box( real_type x0, real_type x1, unsigned N, int P, int coord, real_type& lx0, real_type& lx1)
+{
+    if( N%P == 0)
+    {
+        lx0 = x0 + (x1-x0)/(real_type)P*(real_type)coord;
+        lx1 = x0 + (x1-x0)/(real_type)P*(real_type)(coord+1);
+    }
+    else
+    {
+        unsigned start = cells_start( N, P, coord);
+        lx0 = x0 + (x1-x0)/(real_type)N*(real_type)start;
+        lx1 = x0 + (x1-x0)/(real_type)N*(real_type)(start+cells_count(N,P,coord));
+    }
+    if( coord == P-1)
+        lx1 = x1;
+}
+//coordinate of the process whose box surrounds x
+//points outside the grid are flagged with -1 (left) or P (right), points on
+//or less than one cell over the upper boundary belong to the last process
+template<class real_type>
+int cells_coord( real_type x, real_type x0, real_type x1, unsigned N, int P)
+{
+    real_type cell = floor( (x-x0)/(x1-x0)*(real_type)N );
+    if( cell < 0) return -1;
+    if( cell > (real_type)N) return P;
+    if( N%P == 0)
+    {
+        //same rounding as the boxes of cells_box
+        int coord = (int)floor( (x-x0)/(x1-x0)*(real_type)P );
+        return coord >= P ? P-1 : coord;
+    }
+    if( cell == (real_type)N) cell--;
+    return cells_coord( N, P, (unsigned)cell);
+}
+//wrap the coordinates on periodic dimensions, false if a coordinate lies
+//outside a non-periodic dimension
+inline bool cells_wrap( int ndims, const int* dims, const int* periods, int* coords)
+{
+    for( int i=0; i<ndims; i++)
+    {
+        if( coords[i] >= 0 && coords[i] < dims[i])
+            continue;
+        if( !periods[i])
+            return false;
+        coords[i] = (coords[i] + dims[i]) % dims[i];
+    }
+    return true;
+}
+}//namespace detail
 ///@endcond
 
 
@@ -35,6 +108,9 @@ struct RealMPIGrid3d;
  * Represents the global grid coordinates and the process topology.
  * It just divides the given (global) box into nonoverlapping (local) subboxes that are attributed to each process
  * @note a single cell is never divided across processes.
+ * @note If the number of cells in a direction is not divisible by the number
+ * of processes in that direction the processes with the lowest coordinates
+ * hold one cell more than the others (see \c local_cells)
  * @note although it is abstract, objects are not meant to be hold on the heap via a base class pointer ( we protected the destructor)
  * @attention
  * The access functions \c n() \c Nx() ,... all return the global parameters. If you want to have the local ones call the \c local() function.
@@ -199,14 +275,16 @@ struct aRealMPITopology2d
     */
     bool local2globalIdx( int localIdx, int PID, int& globalIdx)const
     {
-        if( localIdx < 0 || localIdx >= (int)size()) return -1;
         int coords[2];
         if( MPI_Cart_coords( comm, PID, 2, coords) != MPI_SUCCESS)
             return false;
-        int lIdx0 = localIdx %(l.n()*l.Nx());
-        int lIdx1 = localIdx /(l.n()*l.Nx());
-        int gIdx0 = coords[0]*l.n()*l.Nx()+lIdx0;
-        int gIdx1 = coords[1]*l.n()*l.Ny()+lIdx1;
+        unsigned start[2], count[2];
+        local_cells( coords, start, count);
+        if( localIdx < 0 || localIdx >= (int)(g.n()*g.n()*count[0]*count[1])) return false;
+        int lIdx0 = localIdx %(g.n()*count[0]);
+        int lIdx1 = localIdx /(g.n()*count[0]);
+        int gIdx0 = start[0]*g.n()+lIdx0;
+        int gIdx1 = start[1]*g.n()+lIdx1;
         globalIdx = gIdx1*g.n()*g.Nx() + gIdx0;
         return true;
     }
@@ -220,15 +298,18 @@ struct aRealMPITopology2d
     */
     bool global2localIdx( int globalIdx, int& localIdx, int& PID)const
     {
-        if( globalIdx < 0 || globalIdx >= (int)g.size()) return -1;
-        int coords[2];
+        if( globalIdx < 0 || globalIdx >= (int)g.size()) return false;
+        int dims[2], periods[2], coords[2];
+        MPI_Cart_get( comm, 2, dims, periods, coords);
         int gIdx0 = globalIdx%(g.n()*g.Nx());
         int gIdx1 = globalIdx/(g.n()*g.Nx());
-        coords[0] = gIdx0/(l.n()*l.Nx());
-        coords[1] = gIdx1/(l.n()*l.Ny());
-        int lIdx0 = gIdx0%(l.n()*l.Nx());
-        int lIdx1 = gIdx1%(l.n()*l.Ny());
-        localIdx = lIdx1*l.n()*l.Nx() + lIdx0;
+        coords[0] = detail::cells_coord( g.Nx(), dims[0], gIdx0/g.n());
+        coords[1] = detail::cells_coord( g.Ny(), dims[1], gIdx1/g.n());
+        unsigned start[2], count[2];
+        local_cells( coords, start, count);
+        int lIdx0 = gIdx0 - start[0]*g.n();
+        int lIdx1 = gIdx1 - start[1]*g.n();
+        localIdx = lIdx1*g.n()*count[0] + lIdx0;
         if( MPI_Cart_rank( comm, coords, &PID) == MPI_SUCCESS )
             return true;
         else
@@ -237,6 +318,27 @@ struct aRealMPITopology2d
             return false;
         }
     }
+    /**
+     * @brief The cells a process is in charge of
+     *
+     * Cells are distributed as evenly as possible: if the number of cells
+     * in a direction is not divisible by the number of processes in that
+     * direction the processes with the lowest coordinates hold one cell more
+     * than the others
+     * @param coords the Cartesian coordinates of a process in the communicator
+     * @param start global index of the first cell of the process in x and y (contains result on output)
+     * @param count number of cells of the process in x and y (contains result on output)
+     * @note for the calling process \c count equals \c local().Nx() and \c local().Ny()
+     */
+    void local_cells( const int coords[2], unsigned start[2], unsigned count[2]) const
+    {
+        int dims[2], periods[2], my_coords[2];
+        MPI_Cart_get( comm, 2, dims, periods, my_coords);
+        start[0] = detail::cells_start( g.Nx(), dims[0], coords[0]);
+        start[1] = detail::cells_start( g.Ny(), dims[1], coords[1]);
+        count[0] = detail::cells_count( g.Nx(), dims[0], coords[0]);
+        count[1] = detail::cells_count( g.Ny(), dims[1], coords[1]);
+    }
     /**
      * @brief Return a non-MPI grid local for the calling process
      *
@@ -284,12 +386,12 @@ struct aRealMPITopology2d
         MPI_Comm_rank( comm, &rank);
         if( rank == 0)
         {
-            if(Nx%dims[0]!=0)
+            if(Nx<(unsigned)dims[0])
                 std::cerr << "Nx "<<Nx<<" npx "<<dims[0]<<std::endl;
-            assert( Nx%dims[0] == 0);
-            if(Ny%dims[1]!=0)
+            assert( Nx >= (unsigned)dims[0]);
+            if(Ny<(unsigned)dims[1])
                 std::cerr << "Ny "<<Ny<<" npy "<<dims[1]<<std::endl;
-            assert( Ny%dims[1] == 0);
+            assert( Ny >= (unsigned)dims[1]);
             if( bcx == dg::PER) assert( periods[0] == true);
             else assert( periods[0] == false);
             if( bcy == dg::PER) assert( periods[1] == true);
@@ -299,16 +401,11 @@ struct aRealMPITopology2d
     void update_local(){
         int dims[2], periods[2], coords[2];
         MPI_Cart_get( comm, 2, dims, periods, coords);
-        real_type x0 = g.x0() + g.lx()/(real_type)dims[0]*(real_type)coords[0];
-        real_type x1 = g.x0() + g.lx()/(real_type)dims[0]*(real_type)(coords[0]+1);
-        if( coords[0] == dims[0]-1)
-            x1 = g.x1();
-        real_type y0 = g.y0() + g.ly()/(real_type)dims[1]*(real_type)coords[1];
-        real_type y1 = g.y0() + g.ly()/(real_type)dims[1]*(real_type)(coords[1]+1);
-        if( coords[1] == dims[1]-1)
-            y1 = g.y1();
-        unsigned Nx = g.Nx()/dims[0];
-        unsigned Ny = g.Ny()/dims[1];
+        real_type x0, x1, y0, y1;
+        detail::cells_box( g.x0(), g.x1(), g.Nx(), dims[0], coords[0], x0, x1);
+        detail::cells_box( g.y0(), g.y1(), g.Ny(), dims[1], coords[1], y0, y1);
+        unsigned Nx = detail::cells_count( g.Nx(), dims[0], coords[0]);
+        unsigned Ny = detail::cells_count( g.Ny(), dims[1], coords[1]);
         l = RealGrid2d<real_type>(x0, x1, y0, y1, g.n(), Nx, Ny, g.bcx(), g.bcy());
     }
     RealGrid2d<real_type> g, l; //global and local grid
@@ -510,16 +607,18 @@ struct aRealMPITopology3d
     ///@copydoc aRealMPITopology2d::local2globalIdx(int,int,int&)const
     bool local2globalIdx( int localIdx, int PID, int& globalIdx)const
     {
-        if( localIdx < 0 || localIdx >= (int)size()) return false;
         int coords[3];
         if( MPI_Cart_coords( comm, PID, 3, coords) != MPI_SUCCESS)
             return false;
-        int lIdx0 = localIdx %(l.n()*l.Nx());
-        int lIdx1 = (localIdx /(l.n()*l.Nx())) % (l.n()*l.Ny());
-        int lIdx2 = localIdx / (l.n()*l.n()*l.Nx()*l.Ny());
-        int gIdx0 = coords[0]*l.n()*l.Nx()+lIdx0;
-        int gIdx1 = coords[1]*l.n()*l.Ny()+lIdx1;
-        int gIdx2 = coords[2]*l.Nz()  + lIdx2;
+        unsigned start[3], count[3];
+        local_cells( coords, start, count);
+        if( localIdx < 0 || localIdx >= (int)(g.n()*g.n()*count[0]*count[1]*count[2])) return false;
+        int lIdx0 = localIdx %(g.n()*count[0]);
+        int lIdx1 = (localIdx /(g.n()*count[0])) % (g.n()*count[1]);
+        int lIdx2 = localIdx / (g.n()*g.n()*count[0]*count[1]);
+        int gIdx0 = start[0]*g.n()+lIdx0;
+        int gIdx1 = start[1]*g.n()+lIdx1;
+        int gIdx2 = start[2]  + lIdx2;
         globalIdx = (gIdx2*g.n()*g.Ny() + gIdx1)*g.n()*g.Nx() + gIdx0;
         return true;
     }
@@ -527,22 +626,42 @@ struct aRealMPITopology3d
     bool global2localIdx( int globalIdx, int& localIdx, int& PID)const
     {
         if( globalIdx < 0 || globalIdx >= (int)g.size()) return false;
-        int coords[3];
+        int dims[3], periods[3], coords[3];
+        MPI_Cart_get( comm, 3, dims, periods, coords);
         int gIdx0 = globalIdx%(g.n()*g.Nx());
         int gIdx1 = (globalIdx/(g.n()*g.Nx())) % (g.n()*g.Ny());
         int gIdx2 = globalIdx/(g.n()*g.n()*g.Nx()*g.Ny());
-        coords[0] = gIdx0/(l.n()*l.Nx());
-        coords[1] = gIdx1/(l.n()*l.Ny());
-        coords[2] = gIdx2/l.Nz();
-        int lIdx0 = gIdx0%(l.n()*l.Nx());
-        int lIdx1 = gIdx1%(l.n()*l.Ny());
-        int lIdx2 = gIdx2%l.Nz();
-        localIdx = (lIdx2*l.n()*l.Ny() + lIdx1)*l.n()*l.Nx() + lIdx0;
+        coords[0] = detail::cells_coord( g.Nx(), dims[0], gIdx0/g.n());
+        coords[1] = detail::cells_coord( g.Ny(), dims[1], gIdx1/g.n());
+        coords[2] = detail::cells_coord( g.Nz(), dims[2], gIdx2);
+        unsigned start[3], count[3];
+        local_cells( coords, start, count);
+        int lIdx0 = gIdx0 - start[0]*g.n();
+        int lIdx1 = gIdx1 - start[1]*g.n();
+        int lIdx2 = gIdx2 - start[2];
+        localIdx = (lIdx2*g.n()*count[1] + lIdx1)*g.n()*count[0] + lIdx0;
         if( MPI_Cart_rank( comm, coords, &PID) == MPI_SUCCESS )
             return true;
         else
             return false;
     }
+    /**
+     * @copybrief aRealMPITopology2d::local_cells
+     *
+     * @copydetails aRealMPITopology2d::local_cells
+     * @note \c start, \c count and \c coords are ordered x, y, z
+     */
+    void local_cells( const int coords[3], unsigned start[3], unsigned count[3]) const
+    {
+        int dims[3], periods[3], my_coords[3];
+        MPI_Cart_get( comm, 3, dims, periods, my_coords);
+        start[0] = detail::cells_start( g.Nx(), dims[0], coords[0]);
+        start[1] = detail::cells_start( g.Ny(), dims[1], coords[1]);
+        start[2] = detail::cells_start( g.Nz(), dims[2], coords[2]);
+        count[0] = detail::cells_count( g.Nx(), dims[0], coords[0]);
+        count[1] = detail::cells_count( g.Ny(), dims[1], coords[1]);
+        count[2] = detail::cells_count( g.Nz(), dims[2], coords[2]);
+    }
     ///@copydoc aRealMPITopology2d::local()const
     const RealGrid3d<real_type>& local() const {return l;}
      ///@copydoc aRealMPITopology2d::global()const
@@ -577,15 +696,15 @@ struct aRealMPITopology3d
         MPI_Comm_rank( comm, &rank);
         if( rank == 0)
         {
-            if(!(Nx%dims[0]==0))
+            if( Nx<(unsigned)dims[0])
                 std::cerr << "Nx "<<Nx<<" npx "<<dims[0]<<std::endl;
-            assert( Nx%dims[0] == 0);
-            if( !(Ny%dims[1]==0))
+            assert( Nx >= (unsigned)dims[0]);
+            if( Ny<(unsigned)dims[1])
                 std::cerr << "Ny "<<Ny<<" npy "<<dims[1]<<std::endl;
-            assert( Ny%dims[1] == 0);
-            if( !(Nz%dims[2]==0))
+            assert( Ny >= (unsigned)dims[1]);
+            if( Nz<(unsigned)dims[2])
                 std::cerr << "Nz "<<Nz<<" npz "<<dims[2]<<std::endl;
-            assert( Nz%dims[2] == 0);
+            assert( Nz >= (unsigned)dims[2]);
             if( bcx == dg::PER) assert( periods[0] == true);
             else assert( periods[0] == false);
             if( bcy == dg::PER) assert( periods[1] == true);
@@ -597,23 +716,13 @@ struct aRealMPITopology3d
     void update_local(){
         int dims[3], periods[3], coords[3];
         MPI_Cart_get( comm, 3, dims, periods, coords);
-        real_type x0 = g.x0() + g.lx()/(real_type)dims[0]*(real_type)coords[0];
-        real_type x1 = g.x0() + g.lx()/(real_type)dims[0]*(real_type)(coords[0]+1);
-        if( coords[0] == dims[0]-1)
-            x1 = g.x1();
-
-        real_type y0 = g.y0() + g.ly()/(real_type)dims[1]*(real_type)coords[1];
-        real_type y1 = g.y0() + g.ly()/(real_type)dims[1]*(real_type)(coords[1]+1);
-        if( coords[1] == dims[1]-1)
-            y1 = g.y1();
-
-        real_type z0 = g.z0() + g.lz()/(real_type)dims[2]*(real_type)coords[2];
-        real_type z1 = g.z0() + g.lz()/(real_type)dims[2]*(real_type)(coords[2]+1);
-        if( coords[2] == dims[2]-1)
-            z1 = g.z1();
-        unsigned Nx = g.Nx()/dims[0];
-        unsigned Ny = g.Ny()/dims[1];
-        unsigned Nz = g.Nz()/dims[2];
+        real_type x0, x1, y0, y1, z0, z1;
+        detail::cells_box( g.x0(), g.x1(), g.Nx(), dims[0], coords[0], x0, x1);
+        detail::cells_box( g.y0(), g.y1(), g.Ny(), dims[1], coords[1], y0, y1);
+        detail::cells_box( g.z0(), g.z1(), g.Nz(), dims[2], coords[2], z0, z1);
+        unsigned Nx = detail::cells_count( g.Nx(), dims[0], coords[0]);
+        unsigned Ny = detail::cells_count( g.Ny(), dims[1], coords[1]);
+        unsigned Nz = detail::cells_count( g.Nz(), dims[2], coords[2]);
 
         l = RealGrid3d<real_type>(x0, x1, y0, y1, z0, z1, g.n(), Nx, Ny, Nz, g.bcx(), g.bcy(), g.bcz());
     }
@@ -626,11 +735,11 @@ int aRealMPITopology2d<real_type>::pidOf( real_type x, real_type y) const
 {
     int dims[2], periods[2], coords[2];
     MPI_Cart_get( comm, 2, dims, periods, coords);
-    coords[0] = (unsigned)floor( (x-g.x0())/g.lx()*(real_type)dims[0] );
-    coords[1] = (unsigned)floor( (y-g.y0())/g.ly()*(real_type)dims[1] );
-    //if point lies on or over boundary of last cell shift into current cell (not so good for periodic boundaries)
-    coords[0]=(coords[0]==dims[0]) ? coords[0]-1 :coords[0];
-    coords[1]=(coords[1]==dims[1]) ? coords[1]-1 :coords[1];
+    coords[0] = detail::cells_coord( x, g.x0(), g.x1(), g.Nx(), dims[0]);
+    coords[1] = detail::cells_coord( y, g.y0(), g.y1(), g.Ny(), dims[1]);
+    //MPI_Cart_rank is erroneous for coordinates outside non-periodic dimensions
+    if( !detail::cells_wrap( 2, dims, periods, coords))
+        return -1;
     int rank;
     if( MPI_Cart_rank( comm, coords, &rank) == MPI_SUCCESS )
         return rank;
@@ -642,13 +751,12 @@ int aRealMPITopology3d<real_type>::pidOf( real_type x, real_type y, real_type z)
 {
     int dims[3], periods[3], coords[3];
     MPI_Cart_get( comm, 3, dims, periods, coords);
-    coords[0] = (unsigned)floor( (x-g.x0())/g.lx()*(real_type)dims[0] );
-    coords[1] = (unsigned)floor( (y-g.y0())/g.ly()*(real_type)dims[1] );
-    coords[2] = (unsigned)floor( (z-g.z0())/g.lz()*(real_type)dims[2] );
-    //if point lies on or over boundary of last cell shift into current cell (not so good for periodic boundaries)
-    coords[0]=(coords[0]==dims[0]) ? coords[0]-1 :coords[0];
-    coords[1]=(coords[1]==dims[1]) ? coords[1]-1 :coords[1];
-    coords[2]=(coords[2]==dims[2]) ? coords[2]-1 :coords[2];
+    coords[0] = detail::cells_coord( x, g.x0(), g.x1(), g.Nx(), dims[0]);
+    coords[1] = detail::cells_coord( y, g.y0(), g.y1(), g.Ny(), dims[1]);
+    coords[2] = detail::cells_coord( z, g.z0(), g.z1(), g.Nz(), dims[2]);
+    //MPI_Cart_rank is erroneous for coordinates outside non-periodic dimensions
+    if( !detail::cells_wrap( 3, dims, periods, coords))
+        return -1;
     int rank;
     if( MPI_Cart_rank( comm, coords, &rank) == MPI_SUCCESS )
         return rank;
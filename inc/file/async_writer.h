@@ -0,0 +1,152 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/*!@file
+ *
+ * The AsyncWriter class
+ */
+
+namespace dg
+{
+namespace file
+{
+
+/**
+ * @brief Execute output tasks one after the other on a background thread
+ *
+ * The idea is that the caller takes a snapshot of its output fields (e.g.
+ * copies them from the device to host vectors), moves the snapshot into a
+ * task and submits the task. The task does the (slow) NetCDF open, write and
+ * close calls on the writer thread while the caller continues with the
+ * time integration. If the writer falls behind, \c submit blocks until one of
+ * the pending tasks is finished (back-pressure), so the memory needed for the
+ * snapshots is bounded.
+@code
+dg::file::AsyncWriter writer; //at most one task waits while another one is written
+for( unsigned i=1; i<=maxout; i++)
+{
+    // ... integrate in time
+    thrust::host_vector<double> snapshot = dg::construct<thrust::host_vector<double>>( y0);
+    writer.submit( [=, snapshot = std::move(snapshot)]() {
+        dg::file::NC_Error_Handle err;
+        int ncid;
+        err = nc_open( "output.nc", NC_WRITE, &ncid);
+        dg::file::put_vara_double( ncid, varID, i, grid, snapshot);
+        err = nc_close( ncid);
+    });
+}
+writer.wait(); //all output is in the file
+@endcode
+ * @note Tasks are executed in the order in which they are submitted
+ * @attention The NetCDF library is not thread-safe: while tasks are pending
+ * the caller must not call NetCDF functions itself (call \c wait first).
+ * A task must not make MPI calls on a communicator that the main
+ * thread uses at the same time. In particular the MPI versions of
+ * \c dg::file::put_vara_double communicate with the communicator of the grid,
+ * so a task should write with grids constructed on a duplicate (\c MPI_Comm_dup)
+ * of the simulation communicator, and MPI must provide \c MPI_THREAD_MULTIPLE.
+ * @ingroup netcdf
+ */
+struct AsyncWriter
+{
+    /**
+     * @brief Start the writer thread
+     * @param max_pending Maximum number of tasks that wait while another
+     * task is executed (1 means double buffering: one snapshot is written
+     * while the next one is taken)
+     */
+    AsyncWriter( unsigned max_pending = 1) : m_max_pending( max_pending > 0 ? max_pending : 1)
+    {
+        m_thread = std::thread( [this](){ run();});
+    }
+    AsyncWriter( const AsyncWriter&) = delete;
+    AsyncWriter& operator=( const AsyncWriter&) = delete;
+    /// Finish all pending tasks and join the thread (an exception of a task is discarded)
+    ~AsyncWriter(){
+        {
+            std::unique_lock<std::mutex> lock( m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+    /**
+     * @brief Add a task to the queue
+     *
+     * Blocks while \c max_pending tasks are waiting
+     * @param task The task to execute on the writer thread (must own all the data it needs)
+     * @note If a previous task threw an exception it is rethrown here and \c task is not queued
+     */
+    void submit( std::function<void()> task)
+    {
+        std::unique_lock<std::mutex> lock( m_mutex);
+        m_cv.wait( lock, [this](){ return m_tasks.size() < m_max_pending || m_error;});
+        rethrow();
+        m_tasks.push_back( std::move( task));
+        m_cv.notify_all();
+    }
+    /**
+     * @brief Block until all submitted tasks are finished
+     *
+     * @note If a task threw an exception it is rethrown here
+     */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex);
+        m_cv.wait( lock, [this](){ return (m_tasks.empty() && !m_busy) || m_error;});
+        rethrow();
+    }
+    ///@brief Maximum number of tasks that wait while another one is executed
+    ///@return max_pending given in the constructor
+    unsigned max_pending() const{ return m_max_pending;}
+    private:
+    //call with the lock held
+    void rethrow(){
+        if( m_error)
+        {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception( error);
+        }
+    }
+    void run()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex);
+        while( true)
+        {
+            m_cv.wait( lock, [this](){ return m_stop || !m_tasks.empty();});
+            if( m_tasks.empty()) return; //m_stop
+            std::function<void()> task = std::move( m_tasks.front());
+            m_tasks.pop_front();
+            m_busy = true;
+            lock.unlock();
+            std::exception_ptr error;
+            try{
+                task();
+            }catch( ...){
+                error = std::current_exception();
+            }
+            lock.lock();
+            m_busy = false;
+            if( error && !m_error)
+                m_error = error;
+            m_cv.notify_all();
+        }
+    }
+    unsigned m_max_pending;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_busy = false, m_stop = false;
+    std::exception_ptr m_error;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+};
+
+}//namespace file
+}//namespace dg
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include <netcdf.h>
+#include <cmath>
+
+#include "dg/algorithm.h"
+#define _FILE_INCLUDED_BY_DG_
+#include "nc_utilities.h"
+
+double function( double x, double y, double z){return sin(x)*sin(y)*cos(z);}
+
+typedef thrust::host_vector<double> HVec;
+
+int main()
+{
+    std::cout << "WRITE A TIMEDEPENDENT SCALAR AND SCALAR FIELD TO A NETCDF4 FILE IN THE BACKGROUND\n";
+    double Tmax=2.*M_PI;
+    double NT = 10;
+    double h = Tmax/NT;
+    dg::Grid3d g( 0, 2.*M_PI, 0, 2.*M_PI, 0, 2.*M_PI, 3, 10, 10, 20);
+    int ncid;
+    dg::file::NC_Error_Handle err;
+    err = nc_create( "test_async.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+
+    int dim_ids[4], tvarID;
+    err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g);
+
+    int dataID, scalarID;
+    err = nc_def_var( ncid, "data", NC_DOUBLE, 1, dim_ids, &dataID);
+    err = nc_def_var( ncid, "scalar", NC_DOUBLE, 4, dim_ids, &scalarID);
+    err = nc_enddef( ncid);
+    //the fields are written by a background thread while the next ones are computed
+    dg::file::AsyncWriter writer;
+    HVec data;
+    for(unsigned i=0; i<=NT; i++)
+    {
+        double time = i*h;
+        data = dg::evaluate( function, g);
+        dg::blas1::scal( data, cos( time));
+        double energy = dg::blas1::dot( data, data);
+        //the task owns a copy of everything it writes
+        writer.submit( [=, &g](){
+            dg::file::NC_Error_Handle err;
+            const size_t Tcount = 1;
+            const size_t Tstart = i;
+            //write scalar data point
+            err = nc_put_vara_double( ncid, dataID, &Tstart, &Tcount, &energy);
+            //write scalar field
+            dg::file::put_vara_double( ncid, scalarID, i, g, data);
+            //write time
+            err = nc_put_vara_double( ncid, tvarID, &Tstart, &Tcount, &time);
+        });
+    }
+    writer.wait();
+    std::cout << "READ BACK THE LAST SLICE\n";
+    HVec result( data.size());
+    size_t count[4] = {1, g.Nz(), g.n()*g.Ny(), g.n()*g.Nx()};
+    size_t start_last[4] = {(size_t)NT, 0, 0, 0};
+    err = nc_get_vara_double( ncid, scalarID, start_last, count, result.data());
+    dg::blas1::axpby( 1., data, -1., result);
+    double error = sqrt( dg::blas1::dot( result, result));
+    std::cout << "Difference "<<error<<" (should be 0)\n";
+    double time_last;
+    err = nc_get_vara_double( ncid, tvarID, &start_last[0], &count[0], &time_last);
+    std::cout << "Last time "<<time_last<<" (should be "<<NT*h<<")\n";
+
+    std::cout << "EXCEPTIONS OF A TASK ARE RETHROWN BY WAIT\n";
+    writer.submit( [](){ throw dg::Error( dg::Message(_ping_)<<"Expected error");});
+    try{
+        writer.wait();
+        std::cout << "FAILED (no exception)\n";
+    }catch( dg::Error& e){
+        std::cout << "PASSED: "<<e.what()<<"\n";
+    }
+
+    err = nc_close(ncid);
+    return 0;
+}
@@ -198,107 +198,101 @@ void put_vara_double(int ncid, int varid, unsigned slice,
 }
 
 #ifdef MPI_VERSION
-///@copydoc put_var_double()
-template<class host_vector>
-void put_var_double(int ncid, int varid, const dg::aMPITopology2d& grid,
-    const dg::MPI_Vector<host_vector>& data, bool parallel = false)
+///@cond
+namespace detail
 {
-    file::NC_Error_Handle err;
-    size_t start[3] = {0,0}, count[2];
-    count[0] = grid.n()*grid.local().Ny();
-    count[1] = grid.n()*grid.local().Nx();
-    int rank, size;
-    MPI_Comm comm = grid.communicator();
-    MPI_Comm_rank( comm, &rank);
-    MPI_Comm_size( comm, &size);
-    if( !parallel)
-    {
-        MPI_Status status;
-        size_t local_size = grid.local().size();
-        std::vector<int> coords( size*2);
-        for( int rrank=0; rrank<size; rrank++)
-            MPI_Cart_coords( comm, rrank, 2, &coords[2*rrank]);
-        if(rank==0)
-        {
-            host_vector receive( data.data());
-            for( int rrank=0; rrank<size; rrank++)
-            {
-                if(rrank!=0)
-                    MPI_Recv( receive.data(), local_size, MPI_DOUBLE,
-                          rrank, rrank, comm, &status);
-                start[0] = coords[2*rrank+1]*count[0],
-                start[1] = coords[2*rrank+0]*count[1],
-                err = nc_put_vara_double( ncid, varid, start, count,
-                    receive.data());
-            }
-        }
-        else
-            MPI_Send( data.data().data(), local_size, MPI_DOUBLE,
-                      0, rank, comm);
-        MPI_Barrier( comm);
-    }
-    else
-    {
-        int coords[2];
-        MPI_Cart_coords( comm, rank, 2, coords);
-        start[0] = coords[1]*count[0],
-        start[1] = coords[0]*count[1],
-        err = nc_put_vara_double( ncid, varid, start, count,
-            data.data().data());
-    }
+//start and count of the local part of process coords in the netcdf variable
+inline void local_start_count( const dg::aMPITopology2d& grid, const int* coords,
+    size_t* start, size_t* count)
+{
+    unsigned cstart[2], ccount[2];
+    grid.local_cells( coords, cstart, ccount);
+    start[0] = grid.n()*cstart[1], count[0] = grid.n()*ccount[1];
+    start[1] = grid.n()*cstart[0], count[1] = grid.n()*ccount[0];
 }
-
-///@copydoc put_vara_double()
-template<class host_vector>
-void put_vara_double(int ncid, int varid, unsigned slice,
-    const dg::aMPITopology2d& grid, const dg::MPI_Vector<host_vector>& data,
-    bool parallel = false)
+inline void local_start_count( const dg::aMPITopology3d& grid, const int* coords,
+    size_t* start, size_t* count)
+{
+    unsigned cstart[3], ccount[3];
+    grid.local_cells( coords, cstart, ccount);
+    start[0] = cstart[2],          count[0] = ccount[2];
+    start[1] = grid.n()*cstart[1], count[1] = grid.n()*ccount[1];
+    start[2] = grid.n()*cstart[0], count[2] = grid.n()*ccount[0];
+}
+//write the local parts of all processes into the variable either in
+//parallel or by sending them to rank 0 (the local sizes may differ by
+//a few cells, the largest part is held by rank 0)
+template<class Topology, class host_vector>
+void put_vara_mpi(int ncid, int varid, const Topology& grid,
+    const dg::MPI_Vector<host_vector>& data, bool parallel, size_t* start,
+    size_t* count, unsigned offset)
 {
     file::NC_Error_Handle err;
-    size_t start[3] = {slice, 0,0}, count[3];
-    count[0] = 1;
-    count[1] = grid.n()*grid.local().Ny();
-    count[2] = grid.n()*grid.local().Nx();
-    int rank, size;
+    int rank, size, grid_dims;
     MPI_Comm comm = grid.communicator();
+    MPI_Cartdim_get( comm, &grid_dims);
+    //with a time slice the grid dimensions are shifted by one
+    const unsigned ndims = offset + grid_dims;
     MPI_Comm_rank( comm, &rank);
     MPI_Comm_size( comm, &size);
     if( parallel)
     {
-        int coords[2];
-        MPI_Cart_coords( comm, rank, 2, coords);
-        start[1] = coords[1]*count[1],
-        start[2] = coords[0]*count[2],
+        int coords[3];
+        MPI_Cart_coords( comm, rank, grid_dims, coords);
+        local_start_count( grid, coords, start+offset, count+offset);
         err = nc_put_vara_double( ncid, varid, start, count,
             data.data().data());
     }
     else
     {
         MPI_Status status;
-        size_t local_size = grid.local().size();
-        std::vector<int> coords( size*2);
+        std::vector<int> coords( size*grid_dims);
         for( int rrank=0; rrank<size; rrank++)
-            MPI_Cart_coords( comm, rrank, 2, &coords[2*rrank]);
+            MPI_Cart_coords( comm, rrank, grid_dims, &coords[grid_dims*rrank]);
         if(rank==0)
         {
             host_vector receive( data.data());
             for( int rrank=0; rrank<size; rrank++)
             {
+                local_start_count( grid, &coords[grid_dims*rrank],
+                    start+offset, count+offset);
+                size_t local_size = 1;
+                for( unsigned u=0; u<ndims; u++)
+                    local_size *= count[u];
                 if(rrank!=0)
                     MPI_Recv( receive.data(), local_size, MPI_DOUBLE,
                           rrank, rrank, comm, &status);
-                start[1] = coords[2*rrank+1]*count[1],
-                start[2] = coords[2*rrank+0]*count[2],
                 err = nc_put_vara_double( ncid, varid, start, count,
                     receive.data());
             }
         }
         else
-            MPI_Send( data.data().data(), local_size, MPI_DOUBLE,
+            MPI_Send( data.data().data(), grid.local().size(), MPI_DOUBLE,
                       0, rank, comm);
         MPI_Barrier( comm);
     }
 }
+}//namespace detail
+///@endcond
+
+///@copydoc put_var_double()
+template<class host_vector>
+void put_var_double(int ncid, int varid, const dg::aMPITopology2d& grid,
+    const dg::MPI_Vector<host_vector>& data, bool parallel = false)
+{
+    size_t start[2] = {0,0}, count[2];
+    detail::put_vara_mpi( ncid, varid, grid, data, parallel, start, count, 0);
+}
+
+///@copydoc put_vara_double()
+template<class host_vector>
+void put_vara_double(int ncid, int varid, unsigned slice,
+    const dg::aMPITopology2d& grid, const dg::MPI_Vector<host_vector>& data,
+    bool parallel = false)
+{
+    size_t start[3] = {slice, 0,0}, count[3] = {1, 0, 0};
+    detail::put_vara_mpi( ncid, varid, grid, data, parallel, start, count, 1);
+}
 
 ///@copydoc put_var_double()
 template<class host_vector>
@@ -306,52 +300,8 @@ void put_var_double(int ncid, int varid,
     const dg::aMPITopology3d& grid, const dg::MPI_Vector<host_vector>& data,
     bool parallel = false)
 {
-    file::NC_Error_Handle err;
     size_t start[3] = {0,0,0}, count[3];
-    count[0] = grid.local().Nz();
-    count[1] = grid.n()*grid.local().Ny();
-    count[2] = grid.n()*grid.local().Nx();
-    int rank, size;
-    MPI_Comm comm = grid.communicator();
-    MPI_Comm_rank( comm, &rank);
-    MPI_Comm_size( comm, &size);
-    if( !parallel)
-    {
-        MPI_Status status;
-        size_t local_size = grid.local().size();
-        std::vector<int> coords( size*3);
-        for( int rrank=0; rrank<size; rrank++)
-            MPI_Cart_coords( comm, rrank, 3, &coords[3*rrank]);
-        if(rank==0)
-        {
-            host_vector receive( data.data());
-            for( int rrank=0; rrank<size; rrank++)
-            {
-                if(rrank!=0)
-                    MPI_Recv( receive.data(), local_size, MPI_DOUBLE,
-                          rrank, rrank, comm, &status);
-                start[0] = coords[3*rrank+2]*count[0],
-                start[1] = coords[3*rrank+1]*count[1],
-                start[2] = coords[3*rrank+0]*count[2];
-                err = nc_put_vara_double( ncid, varid, start, count,
-                    receive.data());
-            }
-        }
-        else
-            MPI_Send( data.data().data(), local_size, MPI_DOUBLE,
-                      0, rank, comm);
-        MPI_Barrier( comm);
-    }
-    else
-    {
-        int coords[3];
-        MPI_Cart_coords( comm, rank, 3, coords);
-        start[0] = coords[2]*count[0],
-        start[1] = coords[1]*count[1],
-        start[2] = coords[0]*count[2];
-        err = nc_put_vara_double( ncid, varid, start, count,
-            data.data().data());
-    }
+    detail::put_vara_mpi( ncid, varid, grid, data, parallel, start, count, 0);
 }
 
 ///@copydoc put_vara_double()
@@ -360,53 +310,8 @@ void put_vara_double(int ncid, int varid, unsigned slice,
     const dg::aMPITopology3d& grid, const dg::MPI_Vector<host_vector>& data,
     bool parallel = false)
 {
-    file::NC_Error_Handle err;
-    size_t start[4] = {slice, 0,0,0}, count[4];
-    count[0] = 1;
-    count[1] = grid.local().Nz();
-    count[2] = grid.n()*grid.local().Ny();
-    count[3] = grid.n()*grid.local().Nx();
-    int rank, size;
-    MPI_Comm comm = grid.communicator();
-    MPI_Comm_rank( comm, &rank);
-    MPI_Comm_size( comm, &size);
-    if( parallel)
-    {
-        int coords[3];
-        MPI_Cart_coords( comm, rank, 3, coords);
-        start[1] = coords[2]*count[1],
-        start[2] = coords[1]*count[2],
-        start[3] = coords[0]*count[3];
-        err = nc_put_vara_double( ncid, varid, start, count,
-            data.data().data());
-    }
-    else
-    {
-        MPI_Status status;
-        size_t local_size = grid.local().size();
-        std::vector<int> coords( size*3);
-        for( int rrank=0; rrank<size; rrank++)
-            MPI_Cart_coords( comm, rrank, 3, &coords[3*rrank]);
-        if(rank==0)
-        {
-            host_vector receive( data.data());
-            for( int rrank=0; rrank<size; rrank++)
-            {
-                if(rrank!=0)
-                    MPI_Recv( receive.data(), local_size, MPI_DOUBLE,
-                          rrank, rrank, comm, &status);
-                start[1] = coords[3*rrank+2]*count[1],
-                start[2] = coords[3*rrank+1]*count[2],
-                start[3] = coords[3*rrank+0]*count[3];
-                err = nc_put_vara_double( ncid, varid, start, count,
-                    receive.data());
-            }
-        }
-        else
-            MPI_Send( data.data().data(), local_size, MPI_DOUBLE,
-                      0, rank, comm);
-        MPI_Barrier( comm);
-    }
+    size_t start[4] = {slice, 0,0,0}, count[4] = {1, 0, 0, 0};
+    detail::put_vara_mpi( ncid, varid, grid, data, parallel, start, count, 1);
 }
 #endif //MPI_VERSION
 
@@ -3,6 +3,7 @@
 #pragma message( "The inclusion of file/nc_utilities.h is deprecated. Please use dg/file/nc_utilities.h")
 #endif //_INCLUDED_BY_DG_
 
+#include <vector>
 #include <netcdf.h>
 #include "thrust/host_vector.h"
 
@@ -13,10 +14,11 @@
 #endif //MPI_VERSION
 
 #include "easy_output.h"
+#include "async_writer.h"
 
 /*!@file
  *
- * The define_dimensions functions
+ * The define_dimensions and define_variable functions
  */
 
 
@@ -285,6 +287,73 @@ inline int define_dimensions( int ncid, int* dimsIDs, int* tvarID, const dg::aRe
     return define_dimensions( ncid, &dimsIDs[1], g, {name_dims[1], name_dims[2], name_dims[3]});
 }
 
+/**
+ * @brief Storage options for a netcdf variable
+ *
+ * The options are applied by \c dg::file::define_variable. The default
+ * values define a plain \c NC_DOUBLE variable with default chunking
+ * and no filters. Compression filters, chunking and quantization
+ * need a file created with \c NC_NETCDF4.
+ * @code
+dg::file::VariableOptions opt;
+opt.type = NC_FLOAT; //store in single precision (the put functions convert)
+opt.chunks = {1, 1, g.n()*g.Ny(), g.n()*g.Nx()}; // one chunk per z-plane and time
+opt.deflate = 4;
+opt.shuffle = true;
+opt.bitround = 12; //keep 12 mantissa bits (lossy)
+err = dg::file::define_variable( ncid, "electrons", 4, dim_ids, &varID, opt);
+ * @endcode
+ */
+struct VariableOptions
+{
+    nc_type type = NC_DOUBLE; //!< storage type of the variable in the file (\c NC_DOUBLE or \c NC_FLOAT)
+    std::vector<size_t> chunks; //!< chunk shape (one entry per dimension); empty means library default
+    int deflate = 0; //!< deflate level between 0 (no compression) and 9
+    bool shuffle = false; //!< apply the shuffle filter (only if \c deflate > 0)
+    int bitround = 0; //!< number of significant mantissa bits to keep (lossy); 0 means lossless
+};
+
+/**
+ * @brief Define a variable with chunking, compression and quantization
+ *
+ * Calls \c nc_def_var, \c nc_def_var_chunking, \c nc_def_var_deflate and \c nc_def_var_quantize
+ * according to \c opt.
+ * @param ncid file ID (file must be in define mode)
+ * @param name Name of the variable
+ * @param ndims number of dimensions
+ * @param dimids dimension IDs (\c ndims elements)
+ * @param varid (write-only) the ID of the new variable
+ * @param opt the storage options
+ * @return netcdf error code if any (\c NC_EINVAL if \c opt.chunks has
+ * neither 0 nor \c ndims elements or if \c opt.bitround is requested but the
+ * library does not support quantization (netcdf < 4.9))
+ * @note Bit-rounding sets the mantissa bits beyond \c opt.bitround to zero
+ * (rounding to nearest), which makes the following deflate filter much more
+ * effective. The relative error is bounded by \f$ 2^{-\text{bitround}}\f$
+ * @note In a file opened for parallel access the filters are only supported by netcdf >= 4.7.4
+ * and all writes to the variable must be collective
+ */
+inline int define_variable( int ncid, const char* name, int ndims, const int* dimids, int* varid, const VariableOptions& opt = {})
+{
+    int retval;
+    if( !opt.chunks.empty() && opt.chunks.size() != (size_t)ndims)
+        return NC_EINVAL;
+    if( (retval = nc_def_var( ncid, name, opt.type, ndims, dimids, varid))){ return retval;}
+    if( !opt.chunks.empty())
+        if( (retval = nc_def_var_chunking( ncid, *varid, NC_CHUNKED, opt.chunks.data()))){ return retval;}
+    if( opt.deflate > 0)
+        if( (retval = nc_def_var_deflate( ncid, *varid, opt.shuffle ? 1 : 0, 1, opt.deflate))){ return retval;}
+    if( opt.bitround > 0)
+    {
+#ifdef NC_QUANTIZE_BITROUND
+        if( (retval = nc_def_var_quantize( ncid, *varid, NC_QUANTIZE_BITROUND, opt.bitround))){ return retval;}
+#else
+        return NC_EINVAL;
+#endif //NC_QUANTIZE_BITROUND
+    }
+    return retval;
+}
+
 
 #ifdef MPI_VERSION
 
@@ -6,8 +6,13 @@
 #include "dg/algorithm.h"
 #define _FILE_INCLUDED_BY_DG_
 #include "nc_utilities.h"
+#include <netcdf_meta.h>
+#if NC_HAS_PARALLEL4
+#include <netcdf_par.h>
+#endif //NC_HAS_PARALLEL4
 
 double function( double x, double y, double z){return sin(x)*sin(y)*cos(z);}
+double function2d( double x, double y){return sin(x)*sin(y);}
 
 int main(int argc, char* argv[])
 {
@@ -59,6 +64,75 @@ int main(int argc, char* argv[])
         if(rank==0)err = nc_put_vara_double( ncid, tvarID, &Tstart, &Tcount, &time);
     }
     if(rank==0)err = nc_close(ncid);
+#if NC_HAS_PARALLEL4
+    //Now every process writes its own hyperslab into the same file
+    //(this is what feltor_mpi does with -DFELTOR_PARALLEL_NETCDF)
+    if(rank==0)std::cout<<"Write the same data in parallel into testmpi_par.nc\n";
+    dg::CartesianMPIGrid3d geo( x0,x1,x0,x1,x0,x1,3,10,10,20, comm);
+    std::unique_ptr<dg::aMPIGeometry2d> geo2d( geo.perp_grid());
+    //only the processes in the first plane hold the 2d field
+    bool write2d = geo.local().z0() - geo.global().z0() < 1e-14;
+    dg::MPI_Vector<thrust::host_vector<double>> data2d = dg::evaluate( function2d, *geo2d);
+    err = nc_create_par( "testmpi_par.nc", NC_NETCDF4|NC_MPIIO|NC_CLOBBER, comm, MPI_INFO_NULL, &ncid);
+    err = dg::file::define_dimensions( ncid, dimids, &tvarID, geo);
+    int dimids2d[3] = {dimids[0], dimids[2], dimids[3]}, data2dID;
+    err = nc_def_var( ncid, "data", NC_DOUBLE, 4, dimids, &dataID);
+    err = nc_def_var( ncid, "data2d", NC_DOUBLE, 3, dimids2d, &data2dID);
+    err = nc_enddef(ncid);
+    err = nc_var_par_access( ncid, dataID, NC_COLLECTIVE);
+    err = nc_var_par_access( ncid, data2dID, NC_COLLECTIVE);
+    err = nc_var_par_access( ncid, tvarID, NC_COLLECTIVE);
+    Tcount = rank==0 ? 1 : 0;
+    for(unsigned i=0; i<=NT; i++)
+    {
+        time = i*dt;
+        Tstart = i;
+        data = dg::evaluate( function, geo);
+        dg::blas1::scal( data, cos( time));
+        dg::file::put_vara_double( ncid, dataID, i, geo, data, true);
+        data2d = dg::evaluate( function2d, *geo2d);
+        dg::blas1::scal( data2d, cos( time));
+        if( write2d)
+            dg::file::put_vara_double( ncid, data2dID, i, *geo2d, data2d, true);
+        else //collective writes need all processes
+        {
+            size_t start2d[3] = {i,0,0}, count2d[3] = {0,0,0};
+            err = nc_put_vara_double( ncid, data2dID, start2d, count2d, data2d.data().data());
+        }
+        err = nc_put_vara_double( ncid, tvarID, &Tstart, &Tcount, &time);
+    }
+    err = nc_close(ncid);
+    if(rank==0)
+    {
+        std::cout << "Read back the last timeslice on rank 0\n";
+        err = nc_open( "testmpi_par.nc", NC_NOWRITE, &ncid);
+        err = nc_inq_varid( ncid, "data", &dataID);
+        err = nc_inq_varid( ncid, "data2d", &data2dID);
+        err = nc_inq_varid( ncid, "time", &tvarID);
+        const dg::Grid3d& global = geo.global();
+        size_t start[4] = {(size_t)NT, 0, 0, 0};
+        size_t count[4] = {1, global.Nz(), global.n()*global.Ny(), global.n()*global.Nx()};
+        thrust::host_vector<double> result( global.size()), result2d( geo2d->global().size());
+        err = nc_get_vara_double( ncid, dataID, start, count, result.data());
+        size_t start2d[3] = {start[0], 0, 0}, count2d[3] = {1, count[2], count[3]};
+        err = nc_get_vara_double( ncid, data2dID, start2d, count2d, result2d.data());
+        double time_last;
+        err = nc_get_vara_double( ncid, tvarID, start, count, &time_last);
+        err = nc_close(ncid);
+
+        thrust::host_vector<double> solution = dg::evaluate( function, global);
+        dg::blas1::scal( solution, cos( time_last));
+        dg::blas1::axpby( 1., solution, -1., result);
+        double error = sqrt( dg::blas1::dot( result, result));
+        std::cout << "Difference in data   "<<error<<" (should be 0)\n";
+        solution = dg::evaluate( function2d, geo2d->global());
+        dg::blas1::scal( solution, cos( time_last));
+        dg::blas1::axpby( 1., solution, -1., result2d);
+        error = sqrt( dg::blas1::dot( result2d, result2d));
+        std::cout << "Difference in data2d "<<error<<" (should be 0)\n";
+        std::cout << "Last time "<<time_last<<" (should be "<<NT*dt<<")\n";
+    }
+#endif //NC_HAS_PARALLEL4
     MPI_Finalize();
     return 0;
 }
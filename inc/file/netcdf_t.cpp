@@ -40,6 +40,14 @@ int main()
     err = nc_def_var( ncid, "vectorX", NC_DOUBLE, 4, dim_ids, &vectorID[0]);
     err = nc_def_var( ncid, "vectorY", NC_DOUBLE, 4, dim_ids, &vectorID[1]);
     err = nc_def_var( ncid, "vectorZ", NC_DOUBLE, 4, dim_ids, &vectorID[2]);
+    //single precision, one chunk per time slice, shuffle and deflate
+    dg::file::VariableOptions opt;
+    opt.type = NC_FLOAT;
+    opt.chunks = {1, g.Nz(), g.n()*g.Ny(), g.n()*g.Nx()};
+    opt.deflate = 1;
+    opt.shuffle = true;
+    int compressedID;
+    err = dg::file::define_variable( ncid, "compressed", 4, dim_ids, &compressedID, opt);
     err = nc_enddef( ncid);
     size_t count[4] = {1, g.Nz(), g.n()*g.Ny(), g.n()*g.Nx()};
     size_t start[4] = {0, 0, 0, 0};
@@ -66,9 +74,17 @@ int main()
         dg::file::put_vara_double( ncid, vectorID[0], i, g, dataX);
         dg::file::put_vara_double( ncid, vectorID[1], i, g, dataY);
         dg::file::put_vara_double( ncid, vectorID[2], i, g, dataZ);
+        dg::file::put_vara_double( ncid, compressedID, i, g, data);
         //write time
         err = nc_put_vara_double( ncid, tvarID, &Tstart, &Tcount, &time);
     }
+    std::cout << "READ BACK THE LAST SLICE OF THE COMPRESSED FLOAT VARIABLE\n";
+    HVec compressed( data.size());
+    size_t start_last[4] = {(size_t)NT, 0, 0, 0};
+    err = nc_get_vara_double( ncid, compressedID, start_last, count, compressed.data());
+    dg::blas1::axpby( 1., data, -1., compressed);
+    double error = sqrt( dg::blas1::dot( compressed, compressed)/dg::blas1::dot( data, data));
+    std::cout << "Relative error "<<error<<" (should be below "<<1e-7<<")\n";
 
     err = nc_close(ncid);
     return 0;
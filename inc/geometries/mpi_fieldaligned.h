@@ -169,7 +169,7 @@ struct Fieldaligned< ProductMPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY
     std::vector<MPI_Vector<dg::View<const LocalContainer>> > m_f;
     std::vector<MPI_Vector<dg::View<LocalContainer>> > m_temp;
     dg::ClonePtr<ProductMPIGeometry> m_g;
-    unsigned m_coords2, m_sizeZ; //number of processes in z
+    unsigned m_startZ, m_sizeZ; //first global plane, number of processes in z
 #ifdef _DG_CUDA_UNAWARE_MPI
     //we need to manually send data through the host
     thrust::host_vector<double> m_send_buffer, m_recv_buffer; //2d size
@@ -203,7 +203,9 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     else assert( grid.Nz() == 1 || grid.hz()==deltaPhi);
     int dims[3], periods[3], coords[3];
     MPI_Cart_get( m_g->communicator(), 3, dims, periods, coords);
-    m_coords2 = coords[2], m_sizeZ = dims[2];
+    unsigned start[3], count[3];
+    grid.local_cells( coords, start, count);
+    m_startZ = start[2], m_sizeZ = dims[2];
     ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
     dg::ClonePtr<aMPIGeometry2d> grid_coarse( grid.perp_grid());
     ///%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%//
@@ -357,7 +359,7 @@ MPI_Vector<container> Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::e
     {
         for( unsigned i0=0; i0<m_Nz; i0++)
         {
-            int idx = (int)(i0+m_coords2*m_Nz)  - (int)p0;
+            int idx = (int)(i0+m_startZ)  - (int)p0;
             if(idx>=0)
                 result[i0] = plus2d[idx];
             else
@@ -376,7 +378,7 @@ MPI_Vector<container> Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::e
         dg::blas1::axpby( -1., init2d, 1., result[0]);
         for(unsigned i0=0; i0<m_Nz; i0++)
         {
-            int idx = ((int)i0 + m_coords2*m_Nz -(int)p0 + globalNz)%globalNz; //shift index
+            int idx = ((int)i0 + m_startZ -(int)p0 + globalNz)%globalNz; //shift index
             thrust::copy( result[idx].data().begin(), result[idx].data().end(), vec3d.data().begin() + i0*m_perp_size);
         }
     }
@@ -323,9 +323,7 @@ struct Explicit
         // MW: don't like this function, if we need more gradients we might
         // want a more flexible solution
         // grad S_ne and grad S_ni
-        dg::blas2::symv( m_dx_N, m_s[0][i], gradS[0]);
-        dg::blas2::symv( m_dy_N, m_s[0][i], gradS[1]);
-        if(!m_p.symmetric)dg::blas2::symv( m_dz, m_s[0][i], gradS[2]);
+        compute_gradient( m_dx_N, m_dy_N, m_s[0][i], gradS);
     }
     void compute_dot_induction( Container& tmp) const {
         m_old_apar.derive( tmp);
@@ -413,7 +411,33 @@ struct Explicit
         dg::blas1::plus( m_masked, +1);
     }
     void compute_apar( double t, std::array<std::array<Container,2>,2>& fields);
+    //the initial guesses of the solvers (for a checkpoint)
+    void save( std::ostream& os) const
+    {
+        m_old_phi.save( os);
+        m_old_psi.save( os);
+        m_old_gammaN.save( os);
+        m_old_apar.save( os);
+    }
+    void load( std::istream& is)
+    {
+        m_old_phi.load( is);
+        m_old_psi.load( is);
+        m_old_gammaN.load( is);
+        m_old_apar.load( is);
+    }
   private:
+    //all derivatives of f in one batch such that the halo exchanges overlap
+    void compute_gradient( const Matrix& dx, const Matrix& dy,
+        const Container& f, std::array<Container,3>& df) const
+    {
+        if( m_p.symmetric)
+            dg::blas2::symv_batch( std::vector<const Matrix*>{&dx, &dy}, f,
+                std::vector<Container*>{&df[0], &df[1]});
+        else
+            dg::blas2::symv_batch( std::vector<const Matrix*>{&dx, &dy, &m_dz},
+                f, std::vector<Container*>{&df[0], &df[1], &df[2]});
+    }
     void compute_phi( double t, const std::array<Container,2>& y);
     void compute_psi( double t);
     void compute_perp( double t,
@@ -784,9 +808,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_psi(
             throw dg::Fail( m_p.eps_gamma);
     }
     //-------Compute Psi and derivatives
-    dg::blas2::symv( m_dx_P, m_phi[0], m_dP[0][0]);
-    dg::blas2::symv( m_dy_P, m_phi[0], m_dP[0][1]);
-    if( !m_p.symmetric) dg::blas2::symv( m_dz, m_phi[0], m_dP[0][2]);
+    compute_gradient( m_dx_P, m_dy_P, m_phi[0], m_dP[0]);
     dg::tensor::scalar_product3d( 1., m_binv,
         m_dP[0][0], m_dP[0][1], m_dP[0][2], m_hh, m_binv, //grad_perp
         m_dP[0][0], m_dP[0][1], m_dP[0][2], 0., m_UE2);
@@ -797,9 +819,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_psi(
         m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
 #endif //DG_MANUFACTURED
     //m_UE2 now contains u_E^2; also update derivatives
-    dg::blas2::symv( m_dx_P, m_phi[1], m_dP[1][0]);
-    dg::blas2::symv( m_dy_P, m_phi[1], m_dP[1][1]);
-    if( !m_p.symmetric) dg::blas2::symv( m_dz, m_phi[1], m_dP[1][2]);
+    compute_gradient( m_dx_P, m_dy_P, m_phi[1], m_dP[1]);
 }
 template<class Geometry, class IMatrix, class Matrix, class Container>
 void Explicit<Geometry, IMatrix, Matrix, Container>::compute_apar(
@@ -836,9 +856,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_apar(
         m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
 #endif //DG_MANUFACTURED
     //----------Compute Derivatives----------------------------//
-    dg::blas2::symv( m_dx_U, m_apar, m_dA[0]);
-    dg::blas2::symv( m_dy_U, m_apar, m_dA[1]);
-    if(!m_p.symmetric) dg::blas2::symv( m_dz, m_apar, m_dA[2]);
+    compute_gradient( m_dx_U, m_dy_U, m_apar, m_dA);
 
     //----------Compute Velocities-----------------------------//
     dg::blas1::axpby( 1., fields[1][0], -1./m_p.mu[0], m_apar, fields[1][0]);
@@ -859,12 +877,8 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_perp(
     for( unsigned i=0; i<2; i++)
     {
         ////////////////////perpendicular dynamics////////////////////////
-        dg::blas2::symv( m_dx_N, y[0][i], m_dN[i][0]);
-        dg::blas2::symv( m_dy_N, y[0][i], m_dN[i][1]);
-        if(!m_p.symmetric) dg::blas2::symv( m_dz, y[0][i], m_dN[i][2]);
-        dg::blas2::symv( m_dx_U, fields[1][i], m_dU[i][0]);
-        dg::blas2::symv( m_dy_U, fields[1][i], m_dU[i][1]);
-        if(!m_p.symmetric) dg::blas2::symv( m_dz, fields[1][i], m_dU[i][2]);
+        compute_gradient( m_dx_N, m_dy_N, y[0][i], m_dN[i]);
+        compute_gradient( m_dx_U, m_dy_U, fields[1][i], m_dU[i]);
         if( m_p.beta == 0){
             dg::blas1::subroutine( routines::ComputePerpConservative(
                 m_p.mu[i], m_p.tau[i]),
@@ -922,17 +936,19 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_parallel(
         m_fa( dg::geo::einsPlus,  m_phi[i], m_plusP[i]);
         dg::geo::ds_centered_bc_along_field( m_fa, 1., m_minusN[i], y[0][i], m_plusN[i], 0., m_temp0, dg::NEU, {0,0});
         dg::geo::ds_centered_bc_along_field( m_fa, 1., m_minusU[i], fields[1][i], m_plusU[i], 0., m_temp1, dg::NEU, {0,0});
+        // all in one sweep: 0:dsN, 1:dsU, 2:N, 3:U, 4:divb, 5:dtN, 6:dtU
+        dg::blas1::fuse( std::tie( m_temp0, m_temp1, fields[0][i],
+                fields[1][i], m_divb, yp[0][i], yp[1][i]),
         //---------------------density--------------------------//
         //density: -Div ( NUb)
-        dg::blas1::pointwiseDot(-1., m_temp0, fields[1][i],
-            -1., fields[0][i], m_temp1, 1., yp[0][i] );
-        dg::blas1::pointwiseDot( -1., fields[0][i],fields[1][i],m_divb,
-            1.,yp[0][i]);
+            dg::on<0,3,2,1,5>( dg::PointwiseDot<double>( -1., -1., 1.)),
+            dg::on<2,3,4,5>( dg::PointwiseDot<double>( -1., 1.)),
         //---------------------velocity-------------------------//
         // Burgers term: -U ds U
-        dg::blas1::pointwiseDot(-1., fields[1][i], m_temp1, 1., yp[1][i]);
+            dg::on<3,1,6>( dg::PointwiseDot<double>( -1., 1.)),
         // force terms: -tau/mu * ds N/N -1/mu * ds Phi
-        dg::blas1::pointwiseDivide( -m_p.tau[i]/m_p.mu[i], m_temp0, fields[0][i], 1., yp[1][i]);
+            dg::on<0,2,6>( dg::PointwiseDivide<double>( -m_p.tau[i]/m_p.mu[i], 1.))
+        );
         dg::geo::ds_centered_bc_along_field( m_fa, -1./m_p.mu[i], m_minusP[i], m_phi[i], m_plusP[i], 1.0, yp[1][i], dg::DIR, {0,0});
         // viscosity: + nu_par Delta_par U/N = nu_par ( Div b dsU + dssU)/N
         // Maybe factor this out in an operator splitting method? To get larger timestep
@@ -1086,10 +1102,11 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::operator()(
         dg::blas1::axpby( 1., m_s, 1.0, yp);
     }
     //mask right hand side in forcing region
-    dg::blas1::pointwiseDot( m_masked, yp[0][0], yp[0][0]);
-    dg::blas1::pointwiseDot( m_masked, yp[0][1], yp[0][1]);
-    dg::blas1::pointwiseDot( m_masked, yp[1][0], yp[1][0]);
-    dg::blas1::pointwiseDot( m_masked, yp[1][1], yp[1][1]);
+    dg::blas1::fuse( std::tie( m_masked, yp[0][0], yp[0][1], yp[1][0], yp[1][1]),
+        dg::on<0,1>( dg::AxyPby<double>( 1., 0.)),
+        dg::on<0,2>( dg::AxyPby<double>( 1., 0.)),
+        dg::on<0,3>( dg::AxyPby<double>( 1., 0.)),
+        dg::on<0,4>( dg::AxyPby<double>( 1., 0.)));
     // sheath boundary conditions
     if( m_sheath_forcing != 0)
     {
@@ -1121,10 +1138,12 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::operator()(
         // u_i = +- sqrt(1+tau)
         dg::blas1::axpby( m_sheath_forcing*sqrt(1+m_p.tau[1]), m_U_sheath, 1.,  yp[1][1]);
     }
-    dg::blas1::pointwiseDot( -1., m_forcing, y[0][0], 1., yp[0][0]);
-    dg::blas1::pointwiseDot( -1., m_forcing, y[0][1], 1., yp[0][1]);
-    dg::blas1::pointwiseDot( -1., m_forcing, m_fields[1][0], 1., yp[1][0]);
-    dg::blas1::pointwiseDot( -1., m_forcing, m_fields[1][1], 1., yp[1][1]);
+    dg::blas1::fuse( std::tie( m_forcing, y[0][0], y[0][1], m_fields[1][0],
+            m_fields[1][1], yp[0][0], yp[0][1], yp[1][0], yp[1][1]),
+        dg::on<0,1,5>( dg::PointwiseDot<double>( -1., 1.)),
+        dg::on<0,2,6>( dg::PointwiseDot<double>( -1., 1.)),
+        dg::on<0,3,7>( dg::PointwiseDot<double>( -1., 1.)),
+        dg::on<0,4,8>( dg::PointwiseDot<double>( -1., 1.)));
 
 #ifdef DG_MANUFACTURED
     dg::blas1::evaluate( yp[0][0], dg::plus_equals(), manufactured::SNe{
@@ -3,8 +3,11 @@
 #include <vector>
 #include <map>
 #include <sstream>
+#include <fstream>
+#include <cstdio>
 #include <cmath>
 #include <csignal>
+#include <chrono>
 
 #ifdef FELTOR_MPI
 #include <mpi.h>
@@ -23,36 +26,61 @@ using IHMatrix = dg::x::IHMatrix;
 using Geometry = dg::x::CylindricalGrid3d;
 #ifdef FELTOR_MPI
 #define MPI_OUT if(rank==0)
+#ifdef FELTOR_PARALLEL_NETCDF
+//all processes open the file and write their own part with collective MPI-IO
+#include <netcdf_par.h>
+#define NC_OUT
+#else //FELTOR_PARALLEL_NETCDF
+#define NC_OUT if(rank==0)
+#endif //FELTOR_PARALLEL_NETCDF
 #else //FELTOR_MPI
 #define MPI_OUT
+#define NC_OUT
 #endif //FELTOR_MPI
 
 #include "init.h"
 #include "init_from_file.h"
 #include "feltordiag.h"
 
+//Each process reads and writes its own raw binary checkpoint file
+std::string checkpoint_file( std::string name)
+{
 #ifdef FELTOR_MPI
+    int rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    name += "." + std::to_string( rank);
+#endif //FELTOR_MPI
+    return name;
+}
+bool is_checkpoint( std::string name)
+{
+    return name.size() > 4 && name.substr( name.size()-4) == ".chk";
+}
+
 //ATTENTION: in slurm should be used with --signal=SIGINT@30 (<signal>@<time in seconds>)
+//The time loop stops after the current inner loop, writes a checkpoint and exits
+//(a second signal terminates the program immediately)
+volatile std::sig_atomic_t stop_signal = 0;
 void sigterm_handler(int signal)
 {
-    int rank;
-    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
-    std::cout << " pid "<<rank<<" sigterm_handler, got signal " << signal << std::endl;
-    MPI_Finalize();
-    exit(signal);
+    stop_signal = signal;
+    std::signal( signal, SIG_DFL);
 }
-#endif //FELTOR_MPI
 
 int main( int argc, char* argv[])
 {
+    const auto wall_start = std::chrono::steady_clock::now();
 #ifdef FELTOR_MPI
     ////////////////////////////////setup MPI///////////////////////////////
-#ifdef _OPENMP
+    //the output is written in the background if MPI_THREAD_MULTIPLE is provided
     int provided;
-    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+#ifdef FELTOR_PROGRESS_THREAD
+    //a dedicated thread progresses the halo exchanges in the background
+    assert( provided >= MPI_THREAD_MULTIPLE && "MPI_THREAD_MULTIPLE required for the progress thread!\n");
+    dg::start_progress_thread();
+#elif defined _OPENMP
     assert( provided >= MPI_THREAD_FUNNELED && "Threaded MPI lib required!\n");
-#else
-    MPI_Init(&argc, &argv);
 #endif
     int periods[3] = {false, false, true}; //non-, non-, periodic
     int rank, size;
@@ -95,17 +123,18 @@ int main( int argc, char* argv[])
     MPI_Bcast( np, 3, MPI_INT, 0, MPI_COMM_WORLD);
     MPI_Comm comm;
     MPI_Cart_create( MPI_COMM_WORLD, 3, np, periods, true, &comm);
+#endif //FELTOR_MPI
     ////////////////////////////// Install signal handler ///////////////////
     std::signal(SIGINT, sigterm_handler);
     std::signal(SIGTERM, sigterm_handler);
-#endif //FELTOR_MPI
     ////////////////////////Parameter initialisation//////////////////////////
     Json::Value js, gs;
     if( argc != 4 && argc != 5)
     {
         MPI_OUT std::cerr << "ERROR: Wrong number of arguments!\nUsage: "
                 << argv[0]<<" [input.json] [geometry.json] [output.nc]\n OR \n"
-                << argv[0]<<" [input.json] [geometry.json] [output.nc] [initial.nc] "<<std::endl;
+                << argv[0]<<" [input.json] [geometry.json] [output.nc] [initial.nc] \n OR \n"
+                << argv[0]<<" [input.json] [geometry.json] [output.nc] [checkpoint.chk] "<<std::endl;
 #ifdef FELTOR_MPI
         MPI_Abort(MPI_COMM_WORLD, -1);
 #endif //FELTOR_MPI
@@ -154,9 +183,10 @@ int main( int argc, char* argv[])
         return -1;
     }
 #ifdef FELTOR_MPI
-    if( np[2] >= (int)p.Nz)
+    //Nz need not be divisible by np[2] but every process needs two planes
+    if( 2*np[2] > (int)p.Nz)
     {
-        MPI_OUT std::cerr << "ERROR: Number of processes in z "<<np[2]<<" may not be larger or equal Nz "<<p.Nz<<std::endl;
+        MPI_OUT std::cerr << "ERROR: Number of processes in z "<<np[2]<<" may not be larger than Nz/2 "<<p.Nz<<std::endl;
         MPI_Finalize();
         return -1;
     }
@@ -179,6 +209,35 @@ int main( int argc, char* argv[])
         , comm
         #endif //FELTOR_MPI
         );
+#ifdef FELTOR_MPI
+    //the projection compresses the local boxes of grid, so every process
+    //must hold exactly cx x cy times its cells of g3d_out
+    {
+        int dims[3], periods[3], coords[3];
+        MPI_Cart_get( comm, 3, dims, periods, coords);
+        bool matches = ( p.Nx == p.cx*p.Nx_out) && ( p.Ny == p.cy*p.Ny_out);
+        for( coords[0]=0; coords[0]<dims[0]; coords[0]++)
+        for( coords[1]=0; coords[1]<dims[1]; coords[1]++)
+        {
+            coords[2] = 0;
+            unsigned start[3], count[3], start_out[3], count_out[3];
+            grid.local_cells( coords, start, count);
+            g3d_out.local_cells( coords, start_out, count_out);
+            if( start[0] != p.cx*start_out[0] || count[0] != p.cx*count_out[0]
+             || start[1] != p.cy*start_out[1] || count[1] != p.cy*count_out[1])
+                matches = false;
+        }
+        if( !matches)
+        {
+            MPI_OUT std::cerr << "ERROR: The compression "<<p.cx<<" x "<<p.cy
+                <<" does not fit the partition of "<<p.Nx<<" x "<<p.Ny
+                <<" cells among "<<dims[0]<<" x "<<dims[1]<<" processes. Every process must hold a multiple of the compression, e.g. choose Nx divisible by "
+                <<p.cx*dims[0]<<" and Ny divisible by "<<p.cy*dims[1]<<std::endl;
+            MPI_Abort( MPI_COMM_WORLD, -1);
+            return -1;
+        }
+    }
+#endif //FELTOR_MPI
     std::unique_ptr<typename Geometry::perpendicular_grid> g2d_out_ptr  ( dynamic_cast<typename Geometry::perpendicular_grid*>( g3d_out.perp_grid()));
 #ifdef FELTOR_MPI
     unsigned local_size2d = g2d_out_ptr->local().size();
@@ -246,7 +305,39 @@ int main( int argc, char* argv[])
             return -1;
         }
     }
-    if( argc == 5)
+    //a checkpoint contains the time, the fields, the state of the time stepper
+    //and the initial guesses of the solvers in this order
+    std::ifstream checkpoint_in;
+    const bool from_checkpoint = argc == 5 && is_checkpoint( argv[4]);
+    if( from_checkpoint)
+    {
+        try{
+            checkpoint_in.open( checkpoint_file( argv[4]), std::ios::binary);
+            if( !checkpoint_in)
+                throw std::runtime_error( "Cannot open "+checkpoint_file( argv[4]));
+            int processes = 1, processesIN;
+#ifdef FELTOR_MPI
+            MPI_Comm_size( MPI_COMM_WORLD, &processes);
+#endif //FELTOR_MPI
+            dg::read_binary( checkpoint_in, processesIN);
+            if( processesIN != processes)
+                throw std::runtime_error( "Checkpoint was written by "+std::to_string(processesIN)+" processes!");
+            DVec zero = dg::construct<DVec>( dg::evaluate( dg::zero, grid));
+            y0[0][0] = y0[0][1] = y0[1][0] = y0[1][1] = zero;
+            dg::read_binary( checkpoint_in, time);
+            dg::read_binary( checkpoint_in, E0);
+            dg::read_binary( checkpoint_in, y0);
+            MPI_OUT std::cout << "RESTART from checkpoint "<<argv[4]<<" at time "<<time<<std::endl;
+        }catch (std::exception& e){
+            MPI_OUT std::cerr << "ERROR occured reading checkpoint "<<argv[4]<<std::endl;
+            std::cerr << e.what()<<std::endl;
+#ifdef FELTOR_MPI
+            MPI_Abort(MPI_COMM_WORLD, -1);
+#endif //FELTOR_MPI
+            return -1;
+        }
+    }
+    else if( argc == 5)
     {
         try{
             y0 = feltor::init_from_file(argv[4], grid, p,time);
@@ -281,7 +372,12 @@ int main( int argc, char* argv[])
     std::string file_name = argv[3];
     int ncid=-1;
     try{
-        MPI_OUT err = nc_create( file_name.data(), NC_NETCDF4|NC_CLOBBER, &ncid);
+#ifdef FELTOR_PARALLEL_NETCDF
+        err = nc_create_par( file_name.data(), NC_NETCDF4|NC_MPIIO|NC_CLOBBER,
+            comm, MPI_INFO_NULL, &ncid);
+#else
+        NC_OUT err = nc_create( file_name.data(), NC_NETCDF4|NC_CLOBBER, &ncid);
+#endif //FELTOR_PARALLEL_NETCDF
     }catch( std::exception& e)
     {
         std::cerr << "ERROR creating file "<<file_name<<std::endl;
@@ -310,51 +406,96 @@ int main( int argc, char* argv[])
     att["inputfile"] = inputfile;
     att["geomfile"] = geomfile;
     for( auto pair : att)
-        MPI_OUT err = nc_put_att_text( ncid, NC_GLOBAL,
+        NC_OUT err = nc_put_att_text( ncid, NC_GLOBAL,
             pair.first.data(), pair.second.size(), pair.second.data());
 
     // Define dimensions (t,z,y,x)
     int dim_ids[4], restart_dim_ids[3], tvarID;
-    MPI_OUT err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g3d_out, {"time", "z", "y", "x"});
-    MPI_OUT err = dg::file::define_dimensions( ncid, restart_dim_ids, grid, {"zr", "yr", "xr"});
+    NC_OUT err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g3d_out, {"time", "z", "y", "x"});
+    NC_OUT err = dg::file::define_dimensions( ncid, restart_dim_ids, grid, {"zr", "yr", "xr"});
     int dim_ids3d[3] = {dim_ids[0], dim_ids[2], dim_ids[3]};
     bool write2d = true;
 #ifdef FELTOR_MPI
     //only the globally first slice should write
     if( !(g3d_out.local().z0() - g3d_out.global().z0() < 1e-14) ) write2d = false;
 #endif //FELTOR_MPI
+#ifdef FELTOR_PARALLEL_NETCDF
+    const bool parallel_nc = true;
+#else
+    const bool parallel_nc = false;
+#endif //FELTOR_PARALLEL_NETCDF
+    //collective writes need all processes, the ones without data write nothing
+    auto set_collective = [&]( int varid){
+#ifdef FELTOR_PARALLEL_NETCDF
+        err = nc_var_par_access( ncid, varid, NC_COLLECTIVE);
+#endif //FELTOR_PARALLEL_NETCDF
+    };
+    auto put_var2d = [&]( int varid, const HVec& data){
+        if(write2d) dg::file::put_var_double( ncid, varid, *g2d_out_ptr, data, parallel_nc);
+#ifdef FELTOR_PARALLEL_NETCDF
+        else
+        {
+            size_t start2d[2] = {0,0}, count2d[2] = {0,0};
+            err = nc_put_vara_double( ncid, varid, start2d, count2d, data.data().data());
+        }
+#endif //FELTOR_PARALLEL_NETCDF
+    };
+    auto put_vara2d = [&]( int varid, size_t slice, const HVec& data){
+        if(write2d) dg::file::put_vara_double( ncid, varid, slice, *g2d_out_ptr, data, parallel_nc);
+#ifdef FELTOR_PARALLEL_NETCDF
+        else
+        {
+            size_t start2d[3] = {slice,0,0}, count2d[3] = {0,0,0};
+            err = nc_put_vara_double( ncid, varid, start2d, count2d, data.data().data());
+        }
+#endif //FELTOR_PARALLEL_NETCDF
+    };
+
+    //storage options of the diagnostics (the restart fields stay lossless double)
+    auto var_options = [&]( const std::string& name){
+        dg::file::VariableOptions opt;
+        opt.type = p.output_type == "float" ? NC_FLOAT : NC_DOUBLE;
+        opt.deflate = p.deflate;
+        opt.shuffle = p.shuffle;
+        opt.bitround = p.bitround;
+        if( p.chunks.count( name))
+            opt.chunks = p.chunks.at( name);
+        return opt;
+    };
 
     //create & output static 3d variables into file
     for ( auto& record : feltor::diagnostics3d_static_list)
     {
         int vecID;
-        MPI_OUT err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 3,
-            &dim_ids[1], &vecID);
-        MPI_OUT err = nc_put_att_text( ncid, vecID,
+        NC_OUT err = dg::file::define_variable( ncid, record.name.data(), 3,
+            &dim_ids[1], &vecID, var_options( record.name));
+        NC_OUT err = nc_put_att_text( ncid, vecID,
             "long_name", record.long_name.size(), record.long_name.data());
-        MPI_OUT err = nc_enddef( ncid);
+        NC_OUT err = nc_enddef( ncid);
+        set_collective( vecID);
         MPI_OUT std::cout << "Computing "<<record.name<<"\n";
         record.function( transferH, var, g3d_out);
         //record.function( resultH, var, grid);
         //dg::blas2::symv( projectH, resultH, transferH);
-        dg::file::put_var_double( ncid, vecID, g3d_out, transferH);
-        MPI_OUT err = nc_redef(ncid);
+        dg::file::put_var_double( ncid, vecID, g3d_out, transferH, parallel_nc);
+        NC_OUT err = nc_redef(ncid);
     }
     //create & output static 2d variables into file
     for ( auto& record : feltor::diagnostics2d_static_list)
     {
         int vecID;
-        MPI_OUT err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 2,
-            &dim_ids[2], &vecID);
-        MPI_OUT err = nc_put_att_text( ncid, vecID,
+        NC_OUT err = dg::file::define_variable( ncid, record.name.data(), 2,
+            &dim_ids[2], &vecID, var_options( record.name));
+        NC_OUT err = nc_put_att_text( ncid, vecID,
             "long_name", record.long_name.size(), record.long_name.data());
-        MPI_OUT err = nc_enddef( ncid);
+        NC_OUT err = nc_enddef( ncid);
+        set_collective( vecID);
         MPI_OUT std::cout << "Computing2d "<<record.name<<"\n";
         //record.function( transferH, var, g3d_out); //ATTENTION: This does not work because feltor internal varialbes return full grid functions
         record.function( resultH, var, grid);
         dg::blas2::symv( projectH, resultH, transferH);
-        if(write2d)dg::file::put_var_double( ncid, vecID, *g2d_out_ptr, transferH);
-        MPI_OUT err = nc_redef(ncid);
+        put_var2d( vecID, transferH);
+        NC_OUT err = nc_redef(ncid);
     }
 
     //Create field IDs
@@ -363,9 +504,9 @@ int main( int argc, char* argv[])
         std::string name = record.name;
         std::string long_name = record.long_name;
         id4d[name] = 0;//creates a new id4d entry for all processes
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 4, dim_ids,
-            &id4d.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, id4d.at(name), "long_name", long_name.size(),
+        NC_OUT err = dg::file::define_variable( ncid, name.data(), 4, dim_ids,
+            &id4d.at(name), var_options( name));
+        NC_OUT err = nc_put_att_text( ncid, id4d.at(name), "long_name", long_name.size(),
             long_name.data());
     }
     for( auto& record : feltor::restart3d_list)
@@ -373,9 +514,9 @@ int main( int argc, char* argv[])
         std::string name = record.name;
         std::string long_name = record.long_name;
         restart_ids[name] = 0;//creates a new entry for all processes
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, restart_dim_ids,
+        NC_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, restart_dim_ids,
             &restart_ids.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, restart_ids.at(name), "long_name", long_name.size(),
+        NC_OUT err = nc_put_att_text( ncid, restart_ids.at(name), "long_name", long_name.size(),
             long_name.data());
     }
     for( auto& record : feltor::diagnostics2d_list)
@@ -383,20 +524,31 @@ int main( int argc, char* argv[])
         std::string name = record.name + "_ta2d";
         std::string long_name = record.long_name + " (Toroidal average)";
         id3d[name] = 0;//creates a new id3d entry for all processes
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
-            &id3d.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
+        NC_OUT err = dg::file::define_variable( ncid, name.data(), 3, dim_ids3d,
+            &id3d.at(name), var_options( name));
+        NC_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
             long_name.data());
 
         name = record.name + "_2d";
         long_name = record.long_name + " (Evaluated on phi = 0 plane)";
         id3d[name] = 0;
-        MPI_OUT err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
-            &id3d.at(name));
-        MPI_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
+        NC_OUT err = dg::file::define_variable( ncid, name.data(), 3, dim_ids3d,
+            &id3d.at(name), var_options( name));
+        NC_OUT err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
             long_name.data());
     }
-    MPI_OUT err = nc_enddef(ncid);
+    NC_OUT err = nc_enddef(ncid);
+    //the access mode is reset whenever the file is opened
+    auto set_all_collective = [&](){
+        set_collective( tvarID);
+        for( auto& pair : id4d)
+            set_collective( pair.second);
+        for( auto& pair : restart_ids)
+            set_collective( pair.second);
+        for( auto& pair : id3d)
+            set_collective( pair.second);
+    };
+    set_all_collective();
     ///////////////////////////////////first output/////////////////////////
     MPI_OUT std::cout << "First output ... \n";
     //first, update feltor (to get potential etc.)
@@ -407,7 +559,7 @@ int main( int argc, char* argv[])
         } catch( dg::Fail& fail) {
             MPI_OUT std::cerr << "CG failed to converge in first step to "
                               <<fail.epsilon()<<std::endl;
-            MPI_OUT err = nc_close(ncid);
+            NC_OUT err = nc_close(ncid);
 #ifdef FELTOR_MPI
             MPI_Abort(MPI_COMM_WORLD, -1);
 #endif //FELTOR_MPI
@@ -416,19 +568,22 @@ int main( int argc, char* argv[])
     }
 
     size_t start = 0, count = 1;
-    MPI_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
+#ifdef FELTOR_PARALLEL_NETCDF
+    if( rank != 0) count = 0; //only rank 0 writes the time
+#endif //FELTOR_PARALLEL_NETCDF
+    NC_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
     for( auto& record : feltor::diagnostics3d_list)
     {
         record.function( resultD, var);
         dg::blas2::symv( projectD, resultD, transferD);
         dg::assign( transferD, transferH);
-        dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH);
+        dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH, parallel_nc);
     }
     for( auto& record : feltor::restart3d_list)
     {
         record.function( resultD, var);
         dg::assign( resultD, resultH);
-        dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH);
+        dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH, parallel_nc);
     }
     for( auto& record : feltor::diagnostics2d_list)
     {
@@ -446,7 +601,7 @@ int main( int argc, char* argv[])
         tti.toc();
         MPI_OUT std::cout<< name << " Computing average took "<<tti.diff()<<"\n";
         tti.tic();
-        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+        put_vara2d( id3d.at(name), start, transferH2d);
         tti.toc();
         MPI_OUT std::cout<< name << " 2d output took "<<tti.diff()<<"\n";
         tti.tic();
@@ -456,11 +611,11 @@ int main( int argc, char* argv[])
         feltor::slice_vector3d( transferD, transferD2d, local_size2d);
         dg::assign( transferD2d, transferH2d);
         if( record.integral) time_integrals[name].init( time, transferH2d);
-        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+        put_vara2d( id3d.at(name), start, transferH2d);
         tti.toc();
         MPI_OUT std::cout<< name << " 2d output took "<<tti.diff()<<"\n";
     }
-    MPI_OUT err = nc_close(ncid);
+    NC_OUT err = nc_close(ncid);
     MPI_OUT std::cout << "First write successful!\n";
     ///////////////////////////////////////Timeloop/////////////////////////////////
     //dg::Karniadakis< std::array<std::array<DVec,2>,2 >,
@@ -479,10 +634,89 @@ int main( int argc, char* argv[])
 
     MPI_OUT std::cout << "Initialize Timestepper" << std::endl;
     //karniadakis.init( feltor, implicit, time, y0, p.dt);
-    mp.init( feltor, time, y0, p.dt);
+    if( from_checkpoint)
+    {
+        //continue exactly like the uninterrupted run (no startup steps)
+        try{
+            mp.load( checkpoint_in);
+            feltor.load( checkpoint_in);
+        }catch( std::exception& e){
+            MPI_OUT std::cerr << "ERROR occured reading checkpoint "<<argv[4]<<std::endl;
+            std::cerr << e.what()<<std::endl;
+#ifdef FELTOR_MPI
+            MPI_Abort(MPI_COMM_WORLD, -1);
+#endif //FELTOR_MPI
+            return -1;
+        }
+        checkpoint_in.close();
+    }
+    else
+        mp.init( feltor, time, y0, p.dt);
+    //restart with output.nc.chk as the fourth argument
+    auto write_checkpoint = [&]() -> bool
+    {
+        std::string name = checkpoint_file( file_name+".chk");
+        //write to a temporary file first such that a crash leaves the last checkpoint intact
+        std::ofstream os( name+".tmp", std::ios::binary);
+        int processes = 1;
+#ifdef FELTOR_MPI
+        MPI_Comm_size( MPI_COMM_WORLD, &processes);
+#endif //FELTOR_MPI
+        dg::write_binary( os, processes);
+        dg::write_binary( os, time);
+        dg::write_binary( os, E0);
+        dg::write_binary( os, y0);
+        mp.save( os);
+        feltor.save( os);
+        os.close();
+        if( !os || std::rename( (name+".tmp").data(), name.data()) != 0)
+        {
+            std::cerr << "WARNING: writing checkpoint "<<name<<" failed!"<<std::endl;
+            return false;
+        }
+        return true;
+    };
+    //all processes have to agree to stop (at the same step); the check is
+    //done after every inner_loop steps, where the diagnostics synchronize anyway
+    auto stop_requested = [&]() -> bool
+    {
+        int stop = stop_signal != 0;
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - wall_start).count();
+        if( p.wall_time > 0 && elapsed > p.wall_time)
+            stop = 1;
+#ifdef FELTOR_MPI
+        MPI_Allreduce( MPI_IN_PLACE, &stop, 1, MPI_INT, MPI_MAX, comm);
+#endif //FELTOR_MPI
+        return stop;
+    };
+    //writes the output fields in the background (at most one snapshot waits)
+    dg::file::AsyncWriter writer;
+#ifdef FELTOR_MPI
+    //the writer thread calls MPI while the time stepping communicates
+    int thread_level;
+    MPI_Query_thread( &thread_level);
+    const bool async_output = thread_level >= MPI_THREAD_MULTIPLE;
+    if( !async_output)
+        MPI_OUT std::cout << "MPI_THREAD_MULTIPLE not provided: output is written synchronously\n";
+    //the output grids communicate on a duplicate of comm, such that the
+    //messages and collectives of the writer cannot match the ones of the
+    //time stepping
+    MPI_Comm comm_out;
+    MPI_Comm_dup( comm, &comm_out);
+    Geometry grid_w( Rmin, Rmax, Zmin, Zmax, 0, 2.*M_PI,
+        p.n, p.Nx, p.Ny, p.symmetric ? 1 : p.Nz, p.bcxN, p.bcyN, dg::PER, comm_out);
+    Geometry g3d_out_w( Rmin, Rmax, Zmin, Zmax, 0, 2.*M_PI,
+        p.n_out, p.Nx_out, p.Ny_out, p.symmetric ? 1 : p.Nz_out, p.bcxN, p.bcyN, dg::PER, comm_out);
+#else
+    const bool async_output = true;
+    const Geometry& grid_w = grid, & g3d_out_w = g3d_out;
+#endif //FELTOR_MPI
+    std::unique_ptr<typename Geometry::perpendicular_grid> g2d_out_w( dynamic_cast<typename Geometry::perpendicular_grid*>( g3d_out_w.perp_grid()));
     dg::Timer t;
     t.tic();
     unsigned step = 0;
+    bool stopped = false;
     for( unsigned i=1; i<=p.maxout; i++)
     {
 
@@ -515,16 +749,24 @@ int main( int argc, char* argv[])
                 }
                 step++;
             }
+            //check once per inner loop (a global reduction in MPI)
+            if( stop_requested())
+            {
+                stopped = true;
+                break;
+            }
             dg::Timer tti;
             tti.tic();
             double deltat = time - previous_time;
             double energy = 0, ediff = 0.;
+            //the global sums overlap with the computation of the next records
+            std::vector<dg::blas1::DotFuture<DVec>> energy_parts, ediff_parts;
             for( auto& record : feltor::diagnostics2d_list)
             {
                 if( std::find( feltor::energies.begin(), feltor::energies.end(), record.name) != feltor::energies.end())
                 {
                     record.function( resultD, var);
-                    energy += dg::blas1::dot( resultD, feltor.vol3d());
+                    energy_parts.push_back( dg::blas1::dot_async( resultD, feltor.vol3d()));
                 }
                 if( record.integral)
                 {
@@ -540,10 +782,14 @@ int main( int argc, char* argv[])
                     dg::assign( transferD2d, transferH2d);
                     time_integrals.at(record.name+"_2d").add( time, transferH2d);
                     if( std::find( feltor::energy_diff.begin(), feltor::energy_diff.end(), record.name) != feltor::energy_diff.end())
-                        ediff += dg::blas1::dot( resultD, feltor.vol3d());
+                        ediff_parts.push_back( dg::blas1::dot_async( resultD, feltor.vol3d()));
                 }
 
             }
+            for( auto& part : energy_parts)
+                energy += part.get();
+            for( auto& part : ediff_parts)
+                ediff += part.get();
 
             dEdt = (energy - E0)/deltat;
             E0 = energy;
@@ -571,6 +817,8 @@ int main( int argc, char* argv[])
             tti.toc();
             MPI_OUT std::cout << " Time for internal diagnostics "<<tti.diff()<<"s\n";
         }
+        if( stopped)
+            break;
         ti.toc();
         MPI_OUT std::cout << "\n\t Step "<<step <<" of "
                     << p.inner_loop*p.itstp*p.maxout << " at time "<<time;
@@ -579,34 +827,30 @@ int main( int argc, char* argv[])
         ti.tic();
         //////////////////////////write fields////////////////////////
         start = i;
-        MPI_OUT err = nc_open(file_name.data(), NC_WRITE, &ncid);
-        MPI_OUT err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
+        //take a snapshot of all output fields on the host
+        std::map<std::string, HVec> snapshot3d, snapshot_restart, snapshot2d;
         for( auto& record : feltor::diagnostics3d_list)
         {
             record.function( resultD, var);
             dg::blas2::symv( projectD, resultD, transferD);
-            dg::assign( transferD, transferH);
-            dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH);
+            snapshot3d[record.name] = dg::construct<HVec>( transferD);
         }
         for( auto& record : feltor::restart3d_list)
         {
             record.function( resultD, var);
-            dg::assign( resultD, resultH);
-            dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH);
+            snapshot_restart[record.name] = dg::construct<HVec>( resultD);
         }
         for( auto& record : feltor::diagnostics2d_list)
         {
             if(record.integral) // we already computed the output...
             {
                 std::string name = record.name+"_ta2d";
-                transferH2d = time_integrals.at(name).get_integral();
+                snapshot2d[name] = time_integrals.at(name).get_integral();
                 time_integrals.at(name).flush();
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
 
                 name = record.name+"_2d";
-                transferH2d = time_integrals.at(name).get_integral( );
+                snapshot2d[name] = time_integrals.at(name).get_integral( );
                 time_integrals.at(name).flush( );
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
             }
             else // compute from scratch
             {
@@ -615,20 +859,78 @@ int main( int argc, char* argv[])
 
                 std::string name = record.name+"_ta2d";
                 dg::assign( transferD, transferH);
-                toroidal_average( transferH, transferH2d, false);
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                toroidal_average( transferH, snapshot2d[name], false);
 
                 // 2d data of plane varphi = 0
                 name = record.name+"_2d";
                 feltor::slice_vector3d( transferD, transferD2d, local_size2d);
-                dg::assign( transferD2d, transferH2d);
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                snapshot2d[name] = dg::construct<HVec>( transferD2d);
             }
         }
-        MPI_OUT err = nc_close(ncid);
+        //the task may run on the writer thread while the main loop continues,
+        //so it only uses copies and its own file handle and error handle
+        auto write_fields = [=, snapshot3d = std::move(snapshot3d),
+            snapshot_restart = std::move(snapshot_restart),
+            snapshot2d = std::move(snapshot2d), grid = grid_w,
+            g3d_out = g3d_out_w, g2d_out = *g2d_out_w]()
+        {
+            dg::file::NC_Error_Handle err;
+            int ncid=-1;
+#ifdef FELTOR_PARALLEL_NETCDF
+            err = nc_open_par( file_name.data(), NC_WRITE|NC_MPIIO, comm_out,
+                MPI_INFO_NULL, &ncid);
+            //the access mode is reset whenever the file is opened
+            err = nc_var_par_access( ncid, tvarID, NC_COLLECTIVE);
+            for( auto ids : {&id4d, &restart_ids, &id3d})
+                for( auto& pair : *ids)
+                    err = nc_var_par_access( ncid, pair.second, NC_COLLECTIVE);
+#else
+            NC_OUT err = nc_open(file_name.data(), NC_WRITE, &ncid);
+#endif //FELTOR_PARALLEL_NETCDF
+            size_t start_t = start, count_t = count;
+            NC_OUT err = nc_put_vara_double( ncid, tvarID, &start_t, &count_t, &time);
+            for( auto& pair : snapshot3d)
+                dg::file::put_vara_double( ncid, id4d.at(pair.first), start, g3d_out, pair.second, parallel_nc);
+            for( auto& pair : snapshot_restart)
+                dg::file::put_var_double( ncid, restart_ids.at(pair.first), grid, pair.second, parallel_nc);
+            for( auto& pair : snapshot2d)
+            {
+                if(write2d) dg::file::put_vara_double( ncid, id3d.at(pair.first), start, g2d_out, pair.second, parallel_nc);
+#ifdef FELTOR_PARALLEL_NETCDF
+                else
+                {
+                    size_t start2d[3] = {start,0,0}, count2d[3] = {0,0,0};
+                    err = nc_put_vara_double( ncid, id3d.at(pair.first), start2d, count2d, pair.second.data().data());
+                }
+#endif //FELTOR_PARALLEL_NETCDF
+            }
+            NC_OUT err = nc_close(ncid);
+        };
+        //the file is written while the time stepping continues
+        if( async_output)
+            writer.submit( std::move(write_fields));
+        else
+            write_fields();
+        if( p.checkpoint > 0 && i % p.checkpoint == 0)
+            write_checkpoint();
         ti.toc();
         MPI_OUT std::cout << "\n\t Time for output: "<<ti.diff()<<"s\n\n"<<std::flush;
     }
+    if( stopped)
+    {
+        MPI_OUT std::cout << "\nSTOP requested (signal or wall_time "<<p.wall_time
+                          <<"s) after step "<<step<<" at time "<<time<<"\n";
+        int success = write_checkpoint();
+#ifdef FELTOR_MPI
+        MPI_Allreduce( MPI_IN_PLACE, &success, 1, MPI_INT, MPI_MIN, comm);
+#endif //FELTOR_MPI
+        MPI_OUT std::cout << (success ? "Checkpoint written to " : "ERROR writing checkpoint ")
+                          << file_name<<".chk"<<std::endl;
+    }
+    writer.wait();
+#ifdef FELTOR_MPI
+    MPI_Comm_free( &comm_out);
+#endif //FELTOR_MPI
     t.toc();
     unsigned hour = (unsigned)floor(t.diff()/3600);
     unsigned minute = (unsigned)floor( (t.diff() - hour*3600)/60);
@@ -637,6 +939,7 @@ int main( int argc, char* argv[])
     MPI_OUT std::cout <<"Computation Time \t"<<hour<<":"<<std::setw(2)<<minute<<":"<<second<<"\n";
     MPI_OUT std::cout <<"which is         \t"<<t.diff()/p.itstp/p.maxout/p.inner_loop<<"s/step\n";
 #ifdef FELTOR_MPI
+    dg::stop_progress_thread();
     MPI_Finalize();
 #endif //FELTOR_MPI
 
@@ -59,12 +59,14 @@ std::array<std::array<DVec,2>,2> init_from_file( std::string file_name, const Ge
     int dimsIN[3],  coordsIN[3];
     int periods[3] = {false, false, true}; //non-, non-, periodic
     MPI_Cart_get( grid.communicator(), 3, dimsIN, periods, coordsIN);
-    size_t countIN[3] = {grid_IN.local().Nz(),
-            grid_IN.n()*(grid_IN.local().Ny()),
-            grid_IN.n()*(grid_IN.local().Nx())};
-    size_t startIN[3] = {coordsIN[2]*countIN[0],
-                         coordsIN[1]*countIN[1],
-                         coordsIN[0]*countIN[2]};
+    unsigned cstartIN[3], ccountIN[3];
+    grid_IN.local_cells( coordsIN, cstartIN, ccountIN);
+    size_t countIN[3] = {ccountIN[2],
+            grid_IN.n()*ccountIN[1],
+            grid_IN.n()*ccountIN[0]};
+    size_t startIN[3] = {cstartIN[2],
+                         grid_IN.n()*cstartIN[1],
+                         grid_IN.n()*cstartIN[0]};
     #else //FELTOR_MPI
     size_t startIN[3] = {0, 0, 0};
     size_t countIN[3] = {grid_IN.Nz(), grid_IN.n()*grid_IN.Ny(),
@@ -2,6 +2,7 @@
 #include <map>
 #include <array>
 #include <string>
+#include <vector>
 #include "dg/enums.h"
 #include "json/json.h"
 #include "dg/file/json_utilities.h"
@@ -17,6 +18,12 @@ struct Parameters
     unsigned inner_loop;
     unsigned itstp;
     unsigned maxout;
+    double wall_time; // in seconds (0 means no limit)
+    unsigned checkpoint; // outputs between checkpoints (0 means only on stop)
+    std::string output_type; // "double" or "float"
+    unsigned deflate, bitround;
+    bool shuffle;
+    std::map<std::string, std::vector<size_t>> chunks; // chunk shape per variable
 
     std::vector<double> eps_pol;
     double jfactor;
@@ -64,7 +71,26 @@ struct Parameters
         inner_loop = dg::file::get(mode, js, "inner_loop",1).asUInt();
         itstp   = dg::file::get( mode, js, "itstp", 0).asUInt();
         maxout  = dg::file::get( mode, js, "maxout", 0).asUInt();
+        wall_time = dg::file::get( dg::file::error::is_silent, js, "wall_time", 0.).asDouble();
+        checkpoint = dg::file::get( dg::file::error::is_silent, js, "checkpoint", 0).asUInt();
         eps_time    = dg::file::get( mode, js, "eps_time", 1e-10).asDouble();
+        //the output section is optional (default: uncompressed double)
+        output_type = dg::file::get( dg::file::error::is_silent, js, "output", "type", "double").asString();
+        deflate     = dg::file::get( dg::file::error::is_silent, js, "output", "deflate", 0).asUInt();
+        shuffle     = dg::file::get( dg::file::error::is_silent, js, "output", "shuffle", false).asBool();
+        bitround    = dg::file::get( dg::file::error::is_silent, js, "output", "bitround", 0).asUInt();
+        if( output_type != "double" && output_type != "float")
+        {
+            if( dg::file::error::is_throw == mode)
+                throw std::runtime_error( "Value "+output_type+" for output type is invalid! Must be either double or float\n");
+            else if ( dg::file::error::is_warning == mode)
+                std::cerr << "Value "+output_type+" for output type is invalid!\n";
+            output_type = "double";
+        }
+        if( js.isMember("output") && js["output"].isMember("chunks"))
+            for( auto name : js["output"]["chunks"].getMemberNames())
+                for( auto& c : js["output"]["chunks"][name])
+                    chunks[name].push_back( c.asUInt());
 
         stages      = dg::file::get( mode, js, "stages", 3).asUInt();
         eps_pol.resize(stages);
@@ -207,7 +233,20 @@ struct Parameters
             <<"     Nz_out =                 "<<Nz_out<<"\n"
             <<"     Steps between energies:  "<<inner_loop<<"\n"
             <<"     Energies between output: "<<itstp<<"\n"
-            <<"     Number of outputs:       "<<maxout<<"\n";
+            <<"     Number of outputs:       "<<maxout<<"\n"
+            <<"     Wall time budget (s):    "<<wall_time<<"\n"
+            <<"     Outputs per checkpoint:  "<<checkpoint<<"\n"
+            <<"     Output type:             "<<output_type<<"\n"
+            <<"     Deflate level:           "<<deflate<<"\n"
+            <<"     Shuffle filter:          "<<std::boolalpha<<shuffle<<"\n"
+            <<"     Bitround (0 = lossless): "<<bitround<<"\n";
+        for( auto& pair : chunks)
+        {
+            os <<"     Chunks of "<<pair.first<<":";
+            for( auto c : pair.second)
+                os << " "<<c;
+            os <<"\n";
+        }
         os << "Boundary conditions are: \n"
             <<"     bc density x   = "<<dg::bc2str(bcxN)<<"\n"
             <<"     bc density y   = "<<dg::bc2str(bcyN)<<"\n"
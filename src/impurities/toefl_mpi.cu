@@ -55,6 +55,13 @@ int main( int argc, char* argv[])
     ////////////////////////////////set up computations///////////////////////////
     dg::CartesianMPIGrid2d grid( 0, p.lx, 0, p.ly, p.n, p.Nx, p.Ny, p.bc_x, p.bc_y, comm);
     dg::CartesianMPIGrid2d grid_out( 0, p.lx, 0,p.ly, p.n_out, p.Nx_out, p.Ny_out, p.bc_x, p.bc_y, comm);
+    //the output offsets below assume that every process holds the same number of cells
+    if( p.Nx%np[0] != 0 || p.Ny%np[1] != 0 || p.Nx_out%np[0] != 0 || p.Ny_out%np[1] != 0)
+    {
+        if(rank==0) std::cerr << "ERROR: Nx, Ny, Nx_out and Ny_out must be divisible by the number of processes in x and y!"<<std::endl;
+        MPI_Abort( MPI_COMM_WORLD, -1);
+        return -1;
+    }
     //create RHS
     dg::Diffusion< dg::CartesianMPIGrid2d, dg::MDMatrix, dg::MDVec > diffusion( grid, p);
     dg::ToeflI< dg::CartesianMPIGrid2d, dg::MDMatrix, dg::MDVec > toeflI( grid, p);
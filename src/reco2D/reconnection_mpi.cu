@@ -60,6 +60,13 @@ int main( int argc, char* argv[])
     //Make grids
     dg::MPIGrid2d grid( -p.lxhalf, p.lxhalf, -p.lyhalf, p.lyhalf , p.n, p.Nx, p.Ny, dg::DIR, dg::PER,comm);
     dg::MPIGrid2d grid_out( -p.lxhalf, p.lxhalf, -p.lyhalf, p.lyhalf , p.n_out, p.Nx_out, p.Ny_out, dg::DIR, dg::PER,comm);
+    //the output offsets below assume that every process holds the same number of cells
+    if( p.Nx%np[0] != 0 || p.Ny%np[1] != 0 || p.Nx_out%np[0] != 0 || p.Ny_out%np[1] != 0)
+    {
+        if(rank==0) std::cerr << "ERROR: Nx, Ny, Nx_out and Ny_out must be divisible by the number of processes in x and y!"<<std::endl;
+        MPI_Abort( MPI_COMM_WORLD, -1);
+        return -1;
+    }
      
     //create RHS 
     if(rank==0)std::cout << "Constructing Asela...\n";